@@ -0,0 +1,432 @@
+#include "RandomGenerators.hpp"
+#include "BufferedGenerator.hpp"
+#include "AnyGenerator.hpp"
+
+#ifdef _USE_SIMDPP
+#define SIMDPP_ARCH_X86_SSE2
+#define SIMDPP_ARCH_X86_SSE3
+#define SIMDPP_ARCH_X86_SSSE3
+#define SIMDPP_ARCH_X86_SSE4_1
+
+#include "simdpp/simd.h"
+#include "RandomGeneratorsSIMD.hpp"
+#endif
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+
+using namespace PRNG;
+
+/*
+ * Benchmarks - ns/value and GB/s per generator and operation
+ *
+ * Every measurement runs `warmup` untimed and `repetitions` timed rounds of
+ * `size` values and reports the median and the minimum round. Output is CSV
+ * (default) or JSON on stdout.
+ *
+ *   benchmarks [--format=csv|json] [--repetitions=N] [--warmup=N]
+ *              [--size=N] [--filter=substring] [--simd=baseline|avx2|avx512]
+ *              [--record=FILE] [--baseline=FILE] [--threshold=PERCENT]
+ *
+ * --simd restricts the dispatched kernels (CpuDispatch.hpp) to a level.
+ *
+ * --record writes the results as CSV to FILE. --baseline compares them with
+ * such a file: the run fails (exit code 1) if the throughput of any
+ * operation, taken from the minimum round, is more than --threshold percent
+ * (default 25) below the recorded one. Operations without a throughput
+ * (jump, newSource, ...) or missing from the file are not checked. A
+ * missing file exits with 77, which meson reports as skipped.
+ */
+
+struct Options {
+    std::string format      = "csv";
+    std::size_t repetitions = 11;
+    std::size_t warmup      = 2;
+    std::size_t size        = 1 << 16;
+    std::string filter;
+    std::string record;
+    std::string baseline;
+    double      threshold   = 25;
+};
+
+struct Result {
+    std::string generator;
+    std::string operation;
+    std::size_t values;
+    double      bytesPerValue;
+    double      medianNs;
+    double      minNs;
+};
+
+/* Keeps the compiler from dropping the benchmarked work. */
+template<typename T>
+inline void escape(T&& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct Bench {
+    Options             options;
+    std::vector<Result> results;
+
+    bool enabled(const std::string& generator, const std::string& operation) const {
+        return options.filter.empty() || (generator + "/" + operation).find(options.filter) != std::string::npos;
+    }
+
+    /* f(values) performs `values` operations of `bytesPerValue` bytes each. */
+    template<typename F>
+    void measure(const std::string& generator, const std::string& operation,
+                 std::size_t values, double bytesPerValue, F f) {
+        if(!enabled(generator, operation)) return;
+        for(std::size_t i=0; i<options.warmup; ++i) f(values);
+        std::vector<double> times;
+        for(std::size_t i=0; i<options.repetitions; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            f(values);
+            const auto end = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double, std::nano>(end-start).count());
+        }
+        std::sort(times.begin(), times.end());
+        results.push_back(Result{ generator, operation, values, bytesPerValue,
+                                  times[times.size()/2] / values, times.front() / values });
+    }
+
+    void writeCsv(std::ostream& out) const {
+        out << "generator,operation,values,ns_per_value,min_ns_per_value,gb_per_s\n";
+        for(const Result& r : results) {
+            out << r.generator << "," << r.operation << "," << r.values << ","
+                << r.medianNs << "," << r.minNs << ","
+                << (r.bytesPerValue ? r.bytesPerValue / r.medianNs : 0.) << "\n";
+        }
+        out.flush();
+    }
+
+    void print() const {
+        if(options.format == "json") {
+            std::cout << "[\n";
+            for(std::size_t i=0; i<results.size(); ++i) {
+                const Result& r = results[i];
+                std::cout << "  {\"generator\": \"" << r.generator
+                          << "\", \"operation\": \"" << r.operation
+                          << "\", \"values\": " << r.values
+                          << ", \"ns_per_value\": " << r.medianNs
+                          << ", \"min_ns_per_value\": " << r.minNs
+                          << ", \"gb_per_s\": " << (r.bytesPerValue ? r.bytesPerValue / r.medianNs : 0.)
+                          << "}" << (i+1 < results.size() ? "," : "") << "\n";
+            }
+            std::cout << "]" << std::endl;
+        } else {
+            writeCsv(std::cout);
+        }
+    }
+
+    /* The number of operations slower than the baseline allows; reports them
+       on stderr. Operation names may contain commas, so the numbers are
+       taken from the end of the line. */
+    std::size_t regressions(std::istream& in) const {
+        std::map<std::string, double> baseline;
+        std::string line;
+        std::getline(in, line);
+        while(std::getline(in, line)) {
+            // commas before gb_per_s, min_ns_per_value, ns_per_value, values
+            std::size_t comma[4];
+            std::size_t pos = line.size();
+            unsigned int found = 0;
+            for(; found<4 && pos > 0; ++found) {
+                pos = line.rfind(',', pos-1);
+                if(pos == std::string::npos) break;
+                comma[found] = pos;
+            }
+            if(found < 4) continue;
+            baseline[line.substr(0, comma[3])] = std::stod(line.substr(comma[1]+1, comma[0]-comma[1]-1));
+        }
+        std::size_t count = 0;
+        for(const Result& r : results) {
+            const auto it = baseline.find(r.generator + "," + r.operation);
+            if(r.bytesPerValue == 0 || it == baseline.end()) continue;
+            const double ratio = it->second / r.minNs;
+            if(ratio < 1 - options.threshold/100) {
+                std::cerr << "regression: " << r.generator << "/" << r.operation << " "
+                          << r.minNs << " ns/value, baseline " << it->second << " ns/value ("
+                          << (int)((ratio-1)*100) << "% throughput)" << std::endl;
+                ++count;
+            }
+        }
+        return count;
+    }
+};
+
+static const std::size_t fixedSize = 1024;
+
+template<typename GenImpl>
+void benchValues(Bench& bench, const std::string& name, RandomGenerator<GenImpl> gen) {
+    const std::size_t n = bench.options.size;
+
+    bench.measure(name, "next", n, 8, [&](std::size_t k) {
+        uint64_t acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc ^= gen.next();
+        escape(acc);
+    });
+    bench.measure(name, "rand<uint32_t>", n, 4, [&](std::size_t k) {
+        uint32_t acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc ^= gen.template rand<uint32_t>();
+        escape(acc);
+    });
+    bench.measure(name, "randDouble", n, 8, [&](std::size_t k) {
+        double acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc += gen.randDouble();
+        escape(acc);
+    });
+    bench.measure(name, "randDoubleDense", n, 8, [&](std::size_t k) {
+        double acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc += gen.randDoubleDense();
+        escape(acc);
+    });
+    bench.measure(name, "randFloat", n, 4, [&](std::size_t k) {
+        float acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc += gen.randFloat();
+        escape(acc);
+    });
+    bench.measure(name, "randRange<uint32_t>(0,1000)", n, 4, [&](std::size_t k) {
+        uint32_t acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc += gen.randRange(0u, 1000u);
+        escape(acc);
+    });
+    bench.measure(name, "randRange<int64_t>(-3,1e15)", n, 8, [&](std::size_t k) {
+        int64_t acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc += gen.randRange((int64_t)-3, (int64_t)1000000000000000);
+        escape(acc);
+    });
+    bench.measure(name, "randBool", n, 0, [&](std::size_t k) {
+        unsigned int acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc += gen.randBool();
+        escape(acc);
+    });
+    bench.measure(name, "randNarrow<uint8_t>", n, 1, [&](std::size_t k) {
+        unsigned int acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc += gen.template randNarrow<uint8_t>();
+        escape(acc);
+    });
+    bench.measure(name, "randNormal", n, 8, [&](std::size_t k) {
+        double acc = 0;
+        for(std::size_t i=0; i<k; ++i) acc += gen.randNormal();
+        escape(acc);
+    });
+
+    std::vector<uint64_t> u64(n);
+    std::vector<double>   f64(n);
+    std::vector<float>    f32(n);
+    std::vector<int>      i32(n);
+    std::vector<uint32_t> r32(n);
+    bench.measure(name, "fill(uint64_t*)", n, 8, [&](std::size_t k) {
+        gen.fill(u64.data(), k);
+        escape(u64);
+    });
+    bench.measure(name, "fill(double*)", n, 8, [&](std::size_t k) {
+        gen.fill(f64.data(), k);
+        escape(f64);
+    });
+    bench.measure(name, "fillDense(double*)", n, 8, [&](std::size_t k) {
+        gen.fillDense(f64.data(), k);
+        escape(f64);
+    });
+    bench.measure(name, "fill(float*)", n, 4, [&](std::size_t k) {
+        gen.fill(f32.data(), k);
+        escape(f32);
+    });
+    bench.measure(name, "fillFloatPairs(float*)", n, 4, [&](std::size_t k) {
+        gen.fillFloatPairs(f32.data(), k);
+        escape(f32);
+    });
+    bench.measure(name, "fill(int*)", n, 4, [&](std::size_t k) {
+        gen.fill(i32.data(), k);
+        escape(i32);
+    });
+    bench.measure(name, "fill(int*,modifier)", n, 4, [&](std::size_t k) {
+        gen.fill(i32.data(), k, [](int a) { return a >> 1; });
+        escape(i32);
+    });
+    bench.measure(name, "fill<int>(storage,size)", n, 4, [&](std::size_t k) {
+        gen.template fill<int>(i32, k);
+        escape(i32);
+    });
+    bench.measure(name, "fill<int,storage>(begin,end)", n, 4, [&](std::size_t) {
+        gen.template fill<int,std::vector<int> >(i32.begin(), i32.end());
+        escape(i32);
+    });
+    bench.measure(name, "fill<int,1024>(int[])", fixedSize, 4, [&](std::size_t) {
+        int a[fixedSize];
+        gen.template fill<int,fixedSize>(a);
+        escape(a);
+    });
+    bench.measure(name, "randVector<int>(size)", n, 4, [&](std::size_t k) {
+        auto v = gen.template randVector<int>(k);
+        escape(v);
+    });
+    bench.measure(name, "randVector<int,1024>", fixedSize, 4, [&](std::size_t) {
+        auto v = gen.template randVector<int,fixedSize>();
+        escape(v);
+    });
+    bench.measure(name, "randArray<int,1024>", fixedSize, 4, [&](std::size_t) {
+        auto a = gen.template randArray<int,fixedSize>();
+        escape(a);
+    });
+    bench.measure(name, "fillRange(uint32_t*,0,1000)", n, 4, [&](std::size_t k) {
+        gen.fillRange(r32.data(), k, 0u, 1000u);
+        escape(r32);
+    });
+    bench.measure(name, "fillNormal(double*)", n, 8, [&](std::size_t k) {
+        gen.fillNormal(f64.data(), k);
+        escape(f64);
+    });
+    bench.measure(name, "shuffle(uint32_t*)", n, 4, [&](std::size_t k) {
+        gen.shuffle(r32.data(), r32.data() + k);
+        escape(r32);
+    });
+    bench.measure(name, "sampleWithoutReplacement(n,n/64)", n/64, 4, [&](std::size_t k) {
+        gen.sampleWithoutReplacement((uint32_t)n, (uint32_t)k, r32.data());
+        escape(r32);
+    });
+}
+
+template<typename GenImpl>
+void benchSources(Bench& bench, const std::string& name, std::false_type) {
+    bench.measure(name, "RandomSpacing creation", 256, 0, [&](std::size_t k) {
+        for(std::size_t i=0; i<k; ++i) {
+            RandomSpacing<GenImpl,true,Splitmix64> source(i);
+            auto gen = source.getGenerator();
+            escape(gen);
+        }
+    });
+}
+
+template<typename GenImpl>
+void benchSources(Bench& bench, const std::string& name, std::true_type) {
+    benchSources<GenImpl>(bench, name, std::false_type());
+
+    auto gen = SequenceSplitting<GenImpl,true,Splitmix64>(4711).getGenerator();
+    bench.measure(name, "jump", 256, 0, [&](std::size_t k) {
+        for(std::size_t i=0; i<k; ++i) gen.jump();
+        escape(gen);
+    });
+
+    // newSource() at depth d: the source has been split d-1 times before
+    for(unsigned int depth : {1, 8, 32, 64, 100}) {
+        SequenceSplitting<GenImpl,true,Splitmix64> source(4711);
+        for(unsigned int d=1; d<depth; ++d) source = source.newSource();
+        bench.measure(name, "newSource depth " + std::to_string(depth), 64, 0, [&](std::size_t k) {
+            for(std::size_t i=0; i<k; ++i) {
+                auto copy = source;
+                auto child = copy.newSource();
+                escape(child);
+            }
+        });
+    }
+}
+
+template<typename GenImpl>
+void benchGenerator(Bench& bench, const std::string& name) {
+    benchValues<GenImpl>(bench, name, RandomSpacing<GenImpl,true,Splitmix64>(4711).getGenerator());
+    benchSources<GenImpl>(bench, name, std::integral_constant<bool, GenImpl::jumpAble>());
+}
+
+// seeds for unseeded sources: entropySeed() and libc rand() it replaced
+void benchSeeding(Bench& bench) {
+    bench.measure("Seeding", "entropySeed", 4096, 0, [&](std::size_t k) {
+        for(std::size_t i=0; i<k; ++i) {
+            uint64_t seed = entropySeed();
+            escape(seed);
+        }
+    });
+    bench.measure("Seeding", "rand() (libc)", 4096, 0, [&](std::size_t k) {
+        for(std::size_t i=0; i<k; ++i) {
+            int seed = rand();
+            escape(seed);
+        }
+    });
+    bench.measure("Seeding", "unseeded SequenceSplitting<Xoshiro256plus>", 256, 0, [&](std::size_t k) {
+        for(std::size_t i=0; i<k; ++i) {
+            SequenceSplitting<Xoshiro256plus,true,Splitmix64> source;
+            auto gen = source.getGenerator();
+            escape(gen);
+        }
+    });
+}
+
+int main(int argc, char** argv) {
+    Bench bench;
+    for(int i=1; i<argc; ++i) {
+        const std::string arg(argv[i]);
+        auto value = [&](const std::string& key) { return arg.substr(key.size()); };
+        if(arg.find("--format=") == 0)           bench.options.format      = value("--format=");
+        else if(arg.find("--repetitions=") == 0) bench.options.repetitions = std::stoul(value("--repetitions="));
+        else if(arg.find("--warmup=") == 0)      bench.options.warmup      = std::stoul(value("--warmup="));
+        else if(arg.find("--size=") == 0)        bench.options.size        = std::stoul(value("--size="));
+        else if(arg.find("--filter=") == 0)      bench.options.filter      = value("--filter=");
+        else if(arg.find("--record=") == 0)      bench.options.record      = value("--record=");
+        else if(arg.find("--baseline=") == 0)    bench.options.baseline    = value("--baseline=");
+        else if(arg.find("--threshold=") == 0)   bench.options.threshold   = std::stod(value("--threshold="));
+        else if(arg == "--simd=baseline")        setSimdLevel(SimdLevel::Baseline);
+        else if(arg == "--simd=avx2")            setSimdLevel(SimdLevel::AVX2);
+        else if(arg == "--simd=avx512")          setSimdLevel(SimdLevel::AVX512);
+        else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--format=csv|json] [--repetitions=N] [--warmup=N] [--size=N] [--filter=substring]"
+                      << " [--simd=baseline|avx2|avx512] [--record=FILE] [--baseline=FILE] [--threshold=PERCENT]" << std::endl;
+            return 1;
+        }
+    }
+    if(bench.options.repetitions == 0 || bench.options.size == 0) {
+        std::cerr << "repetitions and size have to be positive" << std::endl;
+        return 1;
+    }
+
+    benchGenerator<Splitmix64>        (bench, "Splitmix64");
+    benchGenerator<Xorshift1024star>  (bench, "Xorshift1024star");
+    benchGenerator<Xorshift128plus>   (bench, "Xorshift128plus");
+    benchGenerator<Xoroshiro128plus>  (bench, "Xoroshiro128plus");
+    benchGenerator<Xoshiro256plus>    (bench, "Xoshiro256plus");
+    benchGenerator<Xoshiro256starstar>(bench, "Xoshiro256starstar");
+    benchGenerator<Xoshiro256plusX4>  (bench, "Xoshiro256plusX4");
+    benchGenerator<Xoshiro256plusX8>  (bench, "Xoshiro256plusX8");
+    benchGenerator<Xoshiro256starstarX4>(bench, "Xoshiro256starstarX4");
+    benchGenerator<Xoshiro256starstarX8>(bench, "Xoshiro256starstarX8");
+    benchGenerator<Philox4x32>        (bench, "Philox4x32");
+    benchGenerator<BufferedImplementation<Xoshiro256plus> >  (bench, "Buffered<Xoshiro256plus>");
+    benchGenerator<BufferedImplementation<Xoshiro256plusX4> >(bench, "Buffered<Xoshiro256plusX4>");
+    benchGenerator<BufferedImplementation<Xoshiro256plusX8> >(bench, "Buffered<Xoshiro256plusX8>");
+    benchValues<AnyImplementation>(bench, "Any<Xoshiro256plus>", AnyGenerator(RandomSpacing<Xoshiro256plus,true,Splitmix64>(4711).getGeneratorImpl()));
+    benchValues<AnyImplementation>(bench, "Any<Xoshiro256plusX8>", AnyGenerator(RandomSpacing<Xoshiro256plusX8,true,Splitmix64>(4711).getGeneratorImpl()));
+    benchSeeding(bench);
+#ifdef _USE_SIMDPP
+    benchGenerator<Xoshiro256plusSIMDPP>    (bench, "Xoshiro256plusSIMDPP");
+    benchGenerator<Xoshiro256starstarSIMDPP>(bench, "Xoshiro256starstarSIMDPP");
+#endif
+
+    bench.print();
+    if(!bench.options.record.empty()) {
+        std::ofstream out(bench.options.record);
+        bench.writeCsv(out);
+        if(!out) {
+            std::cerr << "can not write " << bench.options.record << std::endl;
+            return 1;
+        }
+    }
+    if(!bench.options.baseline.empty()) {
+        std::ifstream in(bench.options.baseline);
+        if(!in) {
+            std::cerr << "no baseline " << bench.options.baseline << ", record one with --record=FILE" << std::endl;
+            return 77;
+        }
+        const std::size_t count = bench.regressions(in);
+        std::cerr << count << " regressions against " << bench.options.baseline << std::endl;
+        if(count > 0) return 1;
+    }
+    return 0;
+}
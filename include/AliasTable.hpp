@@ -0,0 +1,148 @@
+#ifndef AliasTable_hpp_INCLUDED
+#define AliasTable_hpp_INCLUDED
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <iterator>
+#include <limits>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include "BoundedRange.hpp"
+
+namespace PRNG {
+
+/*
+ * AliasTable - O(1) sampling of a fixed discrete distribution
+ *
+ * Built from n non-negative weights in O(n) with Vose's method. Bin i keeps
+ * its coin threshold and alias index next to each other, so a draw touches
+ * one bin of 2*sizeof(T) bytes.
+ *
+ * A draw takes one 64 bit output x: the high half of x*n (BoundedRange,
+ * rejecting with probability < n/2^64) is the bin, the top bits of the low
+ * half are the coin that decides between the bin and its alias.
+ *
+ * T is the unsigned index type; it limits the number of categories and the
+ * resolution of the coin to 2^-bits(T).
+ */
+template<typename T = uint32_t>
+struct AliasTable {
+    static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
+                  "AliasTable requires an unsigned index type.");
+
+    struct Bin {
+        T threshold;
+        T alias;
+    };
+    using Range = BoundedRange<uint64_t, uint64_t>;
+
+    std::vector<Bin> bins;
+    Range            range;
+    uint64_t         rejectBelow;
+
+    template<typename Weights>
+    explicit AliasTable(const Weights& weights): range(0, 0), rejectBelow(0) {
+        const std::size_t n = std::distance(std::begin(weights), std::end(weights));
+        if(n == 0 || n - 1 > std::numeric_limits<T>::max())
+            throw std::invalid_argument("AliasTable: number of categories out of range");
+
+        double sum = 0;
+        for(const auto& w : weights) {
+            const double d = (double)w;
+            if(!(d >= 0) || !std::isfinite(d))
+                throw std::invalid_argument("AliasTable: weights have to be finite and non-negative");
+            sum += d;
+        }
+        if(!(sum > 0) || !std::isfinite(sum))
+            throw std::invalid_argument("AliasTable: weights have to sum up to a positive value");
+
+        std::vector<double> p;
+        p.reserve(n);
+        for(const auto& w : weights) p.push_back((double)w * n / sum);
+
+        std::vector<T> small, large;
+        for(std::size_t i=0; i<n; ++i) (p[i] < 1. ? small : large).push_back((T)i);
+
+        bins.resize(n);
+        while(!small.empty() && !large.empty()) {
+            const T s = small.back();
+            const T l = large.back();
+            small.pop_back();
+            bins[s] = Bin{ toThreshold(p[s]), l };
+            p[l] = (p[l] + p[s]) - 1.;
+            if(p[l] < 1.) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // what is left has probability one up to rounding
+        for(T i : large) bins[i] = Bin{ std::numeric_limits<T>::max(), i };
+        for(T i : small) bins[i] = Bin{ std::numeric_limits<T>::max(), i };
+
+        range = Range(0, n);
+        rejectBelow = range.threshold();
+    }
+
+    std::size_t size() const { return bins.size(); }
+
+    static T toThreshold(double p) {
+        const double scaled = p * 2. * (double)((T)1 << (8*sizeof(T)-1));
+        return scaled >= (double)std::numeric_limits<T>::max() ? std::numeric_limits<T>::max() : (T)scaled;
+    }
+
+    inline T pick(Range::Wide m) const {
+        const T   index = (T)(m >> 64);
+        const T   coin  = (T)((uint64_t)m >> (64 - 8*sizeof(T)));
+        const Bin bin   = bins[index];
+        return coin < bin.threshold ? index : bin.alias;
+    }
+
+    /* One category drawn with gen.next(). */
+    template<typename Gen>
+    inline T sample(Gen& gen) const {
+        static_assert(std::numeric_limits<typename Gen::IntType>::digits == 64, "AliasTable requires 64 bit outputs.");
+        return pick(range.product([&gen]() { return gen.next(); }));
+    }
+
+    template<typename Gen>
+    inline T operator()(Gen& gen) const {
+        return sample(gen);
+    }
+
+    /*
+     * size categories, the same as repeated sample(gen). Blocks from
+     * gen.next_n() are mapped without branches; a block containing a
+     * rejected output (probability < 256 n/2^64) is redone sequentially.
+     */
+    template<typename Gen>
+    void sample(Gen& gen, T* out, std::size_t size) const {
+        static_assert(std::numeric_limits<typename Gen::IntType>::digits == 64, "AliasTable requires 64 bit outputs.");
+        const std::size_t blockSize = 256;
+        typename Gen::IntType block[blockSize];
+        std::size_t offset = 0;
+        while(offset < size) {
+            const std::size_t n = (size-offset < blockSize) ? size-offset : blockSize;
+            gen.next_n(block, n);
+            bool rejected = false;
+            for(std::size_t i=0; i<n; ++i) {
+                const Range::Wide m = (Range::Wide)block[i] * range.span;
+                out[offset+i] = pick(m);
+                rejected |= ((uint64_t)m < rejectBelow);
+            }
+            if(!rejected) {
+                offset += n;
+                continue;
+            }
+            for(std::size_t i=0; i<n; ++i) {
+                const Range::Wide m = (Range::Wide)block[i] * range.span;
+                if((uint64_t)m >= rejectBelow) out[offset++] = pick(m);
+            }
+        }
+    }
+};
+
+}
+
+#endif // AliasTable_hpp_INCLUDED
@@ -0,0 +1,364 @@
+#ifndef AnyGenerator_hpp_INCLUDED
+#define AnyGenerator_hpp_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <typeinfo>
+#include <stdexcept>
+#include <type_traits>
+#include "RandomGenerators.hpp"
+
+namespace PRNG {
+
+/*
+ * AnyImplementation - a generator implementation chosen at runtime
+ *
+ * The wrapped generator sits behind a virtual interface that works on
+ * blocks: next() serves an inline buffer of blockSize outputs refilled by
+ * one virtual next_n() call, so rand<T>() through AnyGenerator is a load
+ * and a branch, and fill() costs one virtual call per block of
+ * RandomGenerator. The outputs are exactly those of the wrapped generator.
+ *
+ * jump(), long_jump(), jumpAhead() and discard() act at the position of the
+ * consumer: the generator is rewound to the start of the buffer (a copy
+ * kept at each refill) and advanced past the consumed outputs. They throw
+ * std::logic_error if the wrapped generator does not support them.
+ *
+ * weakLowBits is not known at compile time, so the bit reservoir (randBits,
+ * randBool, randNarrow) and shuffle skip the 3 low bits of every generator,
+ * the most any implementation here has. Their values differ from the
+ * concrete RandomGenerator for generators with fewer weak bits; all other
+ * values are the same.
+ */
+struct AnyImplementation: public GeneratorImplementation<AnyImplementation,false> {
+    using IntType = uint64_t;
+    static const std::size_t blockSize = 64;
+    static const unsigned int weakLowBits = 3;
+
+    struct Model {
+        virtual ~Model() {}
+        virtual Model* clone() const = 0;
+        virtual const std::type_info& type() const = 0;
+        virtual void* target() = 0;
+        virtual bool jumpAble() const = 0;
+        /* Marks the position, then the next n outputs into buffer. */
+        virtual void refill(uint64_t* buffer, std::size_t n) = 0;
+        virtual void next_n(uint64_t* out, std::size_t n) = 0;
+        /* Back to the mark and consumed outputs past it. */
+        virtual void rewind(std::size_t consumed) = 0;
+        virtual void jump() = 0;
+        virtual void long_jump() = 0;
+        virtual void jumpAhead(JumpIndex k) = 0;
+        virtual void discard(JumpIndex n) = 0;
+    };
+
+    /* size bytes aligned to align, the block from ::operator new in front */
+    static void* alignedNew(std::size_t size, std::size_t align) {
+        if(align < alignof(void*)) align = alignof(void*);
+        char* block = static_cast<char*>(::operator new(size + align + sizeof(void*)));
+        const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(block) + sizeof(void*);
+        char* p = block + sizeof(void*) + (align - start % align) % align;
+        reinterpret_cast<void**>(p)[-1] = block;
+        return p;
+    }
+    static void alignedDelete(void* p) {
+        if(p) ::operator delete(static_cast<void**>(p)[-1]);
+    }
+
+    template<typename GenImpl>
+    struct ModelOf: Model {
+        static_assert(std::numeric_limits<typename GenImpl::IntType>::digits == 64, "AnyGenerator requires 64 bit outputs.");
+        static_assert(GenImpl::weakLowBits <= AnyImplementation::weakLowBits, "AnyGenerator skips at most 3 weak low bits.");
+
+        GenImpl gen;
+        GenImpl mark;
+
+        explicit ModelOf(const GenImpl& gen_): gen(gen_), mark(gen_) {}
+
+        // the multi-lane generators are over-aligned, which plain new
+        // respects only from C++17 on
+        static void* operator new(std::size_t size) {
+            return alignedNew(size, alignof(ModelOf<GenImpl>));
+        }
+        static void operator delete(void* p) {
+            alignedDelete(p);
+        }
+
+        Model* clone() const override { return new ModelOf<GenImpl>(*this); }
+        const std::type_info& type() const override { return typeid(GenImpl); }
+        void* target() override { return &gen; }
+        bool jumpAble() const override { return GenImpl::jumpAble; }
+
+        void refill(uint64_t* buffer, std::size_t n) override {
+            mark = gen;
+            runKernel([&]() { gen.next_n(buffer, n); });
+        }
+        void next_n(uint64_t* out, std::size_t n) override {
+            runKernel([&]() { gen.next_n(out, n); });
+        }
+        void rewind(std::size_t consumed) override {
+            gen = mark;
+            discardIf(gen, consumed, 0);
+        }
+        void jump() override { jumpIf(gen, 0); }
+        void long_jump() override { longJumpIf(gen, 0); }
+        void jumpAhead(JumpIndex k) override { jumpAheadIf(gen, k, 0); }
+        void discard(JumpIndex n) override { discardIf(gen, n, 0); }
+
+        template<typename G>
+        static auto jumpIf(G& g, int) -> decltype(g.jump(), void()) { g.jump(); }
+        template<typename G>
+        static void jumpIf(G&, long) { unsupported("jump()"); }
+        template<typename G>
+        static auto longJumpIf(G& g, int) -> decltype(g.long_jump(), void()) { g.long_jump(); }
+        template<typename G>
+        static void longJumpIf(G&, long) { unsupported("long_jump()"); }
+        template<typename G>
+        static auto jumpAheadIf(G& g, JumpIndex k, int) -> decltype(g.jumpAhead(k), void()) { g.jumpAhead(k); }
+        template<typename G>
+        static void jumpAheadIf(G&, JumpIndex, long) { unsupported("jumpAhead()"); }
+        template<typename G>
+        static auto discardIf(G& g, JumpIndex n, int) -> decltype(g.discard(n), void()) { g.discard(n); }
+        template<typename G>
+        static void discardIf(G& g, JumpIndex n, long) {
+            for(JumpIndex i=0; i<n; ++i) g.next();
+        }
+
+        static void unsupported(const char* what) {
+            throw std::logic_error(std::string("AnyGenerator: ") + typeid(GenImpl).name() + " has no " + what);
+        }
+    };
+
+    template<typename GenImpl>
+    explicit AnyImplementation(const GenImpl& gen): model(new ModelOf<GenImpl>(gen)) {}
+
+    AnyImplementation(AnyImplementation&& other) = default;
+    AnyImplementation(const AnyImplementation& other):
+        model(other.model->clone()), buffer(other.buffer), pos(other.pos), filled(other.filled) {}
+    AnyImplementation& operator=(AnyImplementation&& other) = default;
+    AnyImplementation& operator=(const AnyImplementation& other) {
+        if(this != &other) *this = AnyImplementation(other);
+        return *this;
+    }
+
+    std::unique_ptr<Model> model;
+    std::array<uint64_t,blockSize> buffer;
+    std::size_t pos    = 0;
+    std::size_t filled = 0;
+
+    inline uint64_t next(void) {
+        if(pos == filled) refill();
+        return buffer[pos++];
+    }
+
+    inline void next_n(uint64_t* out, std::size_t n) {
+        std::size_t i = 0;
+        while(pos < filled && i < n) out[i++] = buffer[pos++];
+        if(i < n) {
+            model->next_n(out + i, n - i);
+            pos = filled = 0;
+        }
+    }
+
+    /* The wrapped generator at the position of the consumer, nullptr if it
+       is not a GenImpl. */
+    template<typename GenImpl>
+    const GenImpl* target() {
+        if(model->type() != typeid(GenImpl)) return nullptr;
+        sync();
+        return static_cast<const GenImpl*>(model->target());
+    }
+    const std::type_info& type() const {
+        return model->type();
+    }
+    bool jumpAble() const {
+        return model->jumpAble();
+    }
+
+    void jump() {
+        sync();
+        model->jump();
+    }
+    void long_jump() {
+        sync();
+        model->long_jump();
+    }
+    void jumpAhead(JumpIndex k) {
+        sync();
+        model->jumpAhead(k);
+    }
+    void discard(JumpIndex n) {
+        sync();
+        model->discard(n);
+    }
+
+private:
+    void refill() {
+        model->refill(buffer.data(), blockSize);
+        pos = 0;
+        filled = blockSize;
+    }
+    /* Drops the buffer, leaving the wrapped generator at the consumer. */
+    void sync() {
+        if(pos < filled) model->rewind(pos);
+        pos = filled = 0;
+    }
+};
+
+using AnyGenerator = RandomGenerator<AnyImplementation>;
+
+#ifdef CPPRAND_EXTERN_TEMPLATES
+extern template struct RandomGenerator<AnyImplementation>;
+#endif
+
+template<>
+struct RandomGenImplInitiator<AnyImplementation> {
+    template<typename GenImpl>
+    static inline AnyImplementation get(const GenImpl& gen) {
+            return AnyImplementation(gen);
+        };
+    /* The implementation of a RandomGenerator, without its bit reservoir */
+    template<typename GenImpl>
+    static inline AnyImplementation get(const RandomGenerator<GenImpl>& gen) {
+            return AnyImplementation(static_cast<const GenImpl&>(gen));
+        };
+};
+
+
+/*
+ * AnySource - a RandomSpacing or SequenceSplitting chosen at runtime
+ *
+ * newSource() and getGenerator() of the wrapped source; the generators
+ * come as AnyGenerator.
+ */
+struct AnySource {
+    struct Model {
+        virtual ~Model() {}
+        virtual Model* clone() const = 0;
+        virtual Model* newSource() = 0;
+        virtual AnyGenerator getGenerator() = 0;
+    };
+
+    template<typename Source>
+    struct ModelOf: Model {
+        Source source;
+
+        explicit ModelOf(const Source& source_): source(source_) {}
+
+        static void* operator new(std::size_t size) {
+            return AnyImplementation::alignedNew(size, alignof(ModelOf<Source>));
+        }
+        static void operator delete(void* p) {
+            AnyImplementation::alignedDelete(p);
+        }
+
+        Model* clone() const override { return new ModelOf<Source>(source); }
+        Model* newSource() override { return new ModelOf<Source>(source.newSource()); }
+        AnyGenerator getGenerator() override { return AnyGenerator(source.getGeneratorImpl()); }
+    };
+
+    template<typename Source,
+        typename std::enable_if<!std::is_same<typename std::decay<Source>::type, AnySource>::value,int>::type=0 >
+    explicit AnySource(const Source& source): model(new ModelOf<Source>(source)) {}
+
+    AnySource(AnySource&& other) = default;
+    AnySource(const AnySource& other): model(other.model->clone()) {}
+    AnySource& operator=(AnySource&& other) = default;
+    AnySource& operator=(const AnySource& other) {
+        if(this != &other) model.reset(other.model->clone());
+        return *this;
+    }
+
+    AnySource newSource() {
+        return AnySource(std::unique_ptr<Model>(model->newSource()));
+    }
+    AnyGenerator getGenerator() {
+        return model->getGenerator();
+    }
+
+private:
+    explicit AnySource(std::unique_ptr<Model>&& model_): model(std::move(model_)) {}
+
+    std::unique_ptr<Model> model;
+};
+
+
+/*
+ * Generators by name, e.g. from a configuration file
+ *
+ * visitGenerator(name, f) calls f(GeneratorTag<GenImpl>()) for the
+ * implementation called name and returns false for unknown names.
+ */
+template<typename GenImpl>
+struct GeneratorTag {
+    using type = GenImpl;
+};
+
+inline const std::vector<std::string>& generatorNames() {
+    static const std::vector<std::string> names = {
+        "splitmix64", "xorshift1024star", "xorshift128plus", "xoroshiro128plus",
+        "xoshiro256plus", "xoshiro256starstar", "xoshiro256plusx4", "xoshiro256plusx8",
+        "xoshiro256starstarx4", "xoshiro256starstarx8", "philox4x32" };
+    return names;
+}
+
+template<typename F>
+bool visitGenerator(const std::string& name, F&& f) {
+    if(name == "splitmix64")                f(GeneratorTag<Splitmix64>());
+    else if(name == "xorshift1024star")     f(GeneratorTag<Xorshift1024star>());
+    else if(name == "xorshift128plus")      f(GeneratorTag<Xorshift128plus>());
+    else if(name == "xoroshiro128plus")     f(GeneratorTag<Xoroshiro128plus>());
+    else if(name == "xoshiro256plus")       f(GeneratorTag<Xoshiro256plus>());
+    else if(name == "xoshiro256starstar")   f(GeneratorTag<Xoshiro256starstar>());
+    else if(name == "xoshiro256plusx4")     f(GeneratorTag<Xoshiro256plusX4>());
+    else if(name == "xoshiro256plusx8")     f(GeneratorTag<Xoshiro256plusX8>());
+    else if(name == "xoshiro256starstarx4") f(GeneratorTag<Xoshiro256starstarX4>());
+    else if(name == "xoshiro256starstarx8") f(GeneratorTag<Xoshiro256starstarX8>());
+    else if(name == "philox4x32")           f(GeneratorTag<Philox4x32>());
+    else return false;
+    return true;
+}
+
+/* RandomGenerator<GenImpl>(seed) of the generator called name. */
+inline AnyGenerator anyGenerator(const std::string& name, uint64_t seed) {
+    std::unique_ptr<AnyGenerator> gen;
+    const bool known = visitGenerator(name, [&](auto tag) {
+        using GenImpl = typename decltype(tag)::type;
+        gen.reset(new AnyGenerator(RandomGenImplInitiator<GenImpl>::get(seed)));
+    });
+    if(!known) throw std::invalid_argument("anyGenerator: unknown generator " + name);
+    return std::move(*gen);
+}
+
+template<typename GenImpl>
+AnySource anySourceOf(const std::string& policy, uint64_t seed, std::false_type) {
+    if(policy == "spacing") return AnySource(RandomSpacing<GenImpl,true,Splitmix64>(seed));
+    if(policy == "splitting")
+        throw std::invalid_argument("anySource: the generator does not support jump ahead, use spacing");
+    throw std::invalid_argument("anySource: unknown policy " + policy);
+}
+template<typename GenImpl>
+AnySource anySourceOf(const std::string& policy, uint64_t seed, std::true_type) {
+    if(policy == "splitting") return AnySource(SequenceSplitting<GenImpl,true,Splitmix64>(seed));
+    return anySourceOf<GenImpl>(policy, seed, std::false_type());
+}
+
+/* RandomSpacing<GenImpl,true,Splitmix64>(seed) for policy "spacing",
+   SequenceSplitting<GenImpl,true,Splitmix64>(seed) for "splitting". */
+inline AnySource anySource(const std::string& name, const std::string& policy, uint64_t seed) {
+    std::unique_ptr<AnySource> source;
+    const bool known = visitGenerator(name, [&](auto tag) {
+        using GenImpl = typename decltype(tag)::type;
+        source.reset(new AnySource(anySourceOf<GenImpl>(policy, seed, std::integral_constant<bool, GenImpl::jumpAble>())));
+    });
+    if(!known) throw std::invalid_argument("anySource: unknown generator " + name);
+    return std::move(*source);
+}
+
+}
+
+#endif // AnyGenerator_hpp_INCLUDED
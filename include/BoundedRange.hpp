@@ -0,0 +1,61 @@
+#ifndef BoundedRange_hpp_INCLUDED
+#define BoundedRange_hpp_INCLUDED
+
+#include <stdint.h>
+#include <type_traits>
+
+namespace PRNG {
+
+/*
+ * Unbiased integers in [start,end) by multiply-shift with rare rejection
+ * (Lemire, "Fast Random Integer Generation in an Interval").
+ *
+ * A raw output x is reduced to a Word (its upper 32 bits for types up to 32
+ * bit) and mapped to the high half of x*span. Raws whose low half falls
+ * below 2^w mod span are rejected; the threshold costs a division but is
+ * only needed when the low half is below span at all.
+ */
+template<typename T, typename Inttype>
+struct BoundedRange {
+    using Word = typename std::conditional<(sizeof(T) <= 4), uint32_t, uint64_t>::type;
+    __extension__ typedef typename std::conditional<(sizeof(T) <= 4), uint64_t, unsigned __int128>::type Wide;
+    using UT   = typename std::make_unsigned<T>::type;
+    static_assert(sizeof(Word) <= sizeof(Inttype), "BoundedRange needs at least Word bits per raw output.");
+
+    T    start;
+    Word span;
+
+    BoundedRange(T start_, T end_): start(start_), span((UT)((UT)end_ - (UT)start_)) {}
+
+    static inline Word word(Inttype x) {
+        return (Word)(x >> (8*(sizeof(Inttype)-sizeof(Word))));
+    }
+    /* 2^w mod span, the rejection threshold for the low half. */
+    inline Word threshold() const {
+        return span ? (Word)(-span) % span : 0;
+    }
+    inline T map(Wide m) const {
+        return (T)((UT)start + (UT)(m >> (8*sizeof(Word))));
+    }
+
+    /* The accepted product; its low half is left for further use, e.g. as
+       the coin of AliasTable. */
+    template<typename Next>
+    inline Wide product(Next&& next) const {
+        Wide m = (Wide)word(next()) * span;
+        if((Word)m < span) {
+            const Word t = threshold();
+            while((Word)m < t) m = (Wide)word(next()) * span;
+        }
+        return m;
+    }
+
+    template<typename Next>
+    inline T operator()(Next&& next) const {
+        return map(product(next));
+    }
+};
+
+}
+
+#endif // BoundedRange_hpp_INCLUDED
@@ -0,0 +1,90 @@
+#ifndef BufferedGenerator_hpp_INCLUDED
+#define BufferedGenerator_hpp_INCLUDED
+
+#include <cstddef>
+#include <array>
+#include <type_traits>
+#include "RandomGenerators.hpp"
+
+namespace PRNG {
+
+/*
+ * BufferedImplementation - serves a generator's outputs from a block buffer
+ *
+ * The buffer is refilled with GenImpl::next_n(), the generator's block
+ * kernel, so scalar consumers pay a load and a branch per value. The output
+ * sequence is exactly the sequence of GenImpl. next_n() empties the buffer
+ * and then calls the kernel of GenImpl directly.
+ *
+ * The buffered outputs are not part of GenImpl's state, so the adapter is
+ * neither jumpable nor usable with the sources.
+ */
+template<typename GenImpl, std::size_t BlockSize = 256>
+struct BufferedImplementation: public GeneratorImplementation<BufferedImplementation<GenImpl,BlockSize>,false> {
+    static_assert(BlockSize > 0, "BufferedImplementation requires a non-empty block.");
+
+    using IntType = typename GenImpl::IntType;
+    static const std::size_t blockSize = BlockSize;
+    static const unsigned int weakLowBits = GenImpl::weakLowBits;
+
+    explicit BufferedImplementation(const GenImpl& gen_): gen(gen_) {}
+
+    GenImpl gen;
+    alignas(64) std::array<IntType,BlockSize> buffer;
+    std::size_t pos = BlockSize;
+
+    /* The wrapped generator, advanced past the buffered outputs. */
+    const GenImpl& generator() const {
+        return gen;
+    }
+    /* Outputs buffered but not yet returned. */
+    std::size_t buffered() const {
+        return BlockSize - pos;
+    }
+
+    inline IntType next(void) {
+        if(pos == BlockSize) refill();
+        return buffer[pos++];
+    }
+
+    inline void next_n(IntType* out, std::size_t n) {
+        std::size_t i = 0;
+        while(pos < BlockSize && i < n) out[i++] = buffer[pos++];
+        if(i < n) gen.next_n(out + i, n - i);
+    }
+
+private:
+    void refill() {
+        runKernel([&]() { gen.next_n(buffer.data(), BlockSize); });
+        pos = 0;
+    }
+};
+
+/* RandomGenerator interface on top of the buffer. */
+template<typename GenImpl, std::size_t BlockSize = 256>
+using BufferedGenerator = RandomGenerator<BufferedImplementation<GenImpl,BlockSize> >;
+
+template<typename GenImpl, std::size_t BlockSize>
+struct RandomGenImplInitiator<BufferedImplementation<GenImpl,BlockSize> > {
+    using Buffered = BufferedImplementation<GenImpl,BlockSize>;
+
+    /* From a generator (or RandomGenerator) of the wrapped type */
+    static inline Buffered get(const GenImpl& gen) {
+            return Buffered(gen);
+        };
+    template<typename ...Args>
+    struct IsWrapped: std::false_type {};
+    template<typename Arg>
+    struct IsWrapped<Arg>: std::is_base_of<GenImpl, typename std::decay<Arg>::type> {};
+
+    /* From anything GenImpl can be initiated with */
+    template<typename ...Args,
+        typename std::enable_if<!IsWrapped<Args...>::value,int>::type=0 >
+    static inline Buffered get(Args&&... args) {
+            return Buffered(RandomGenImplInitiator<GenImpl>::get(std::forward<Args>(args)...));
+        };
+};
+
+}
+
+#endif // BufferedGenerator_hpp_INCLUDED
@@ -0,0 +1,90 @@
+#ifndef CpuDispatch_hpp_INCLUDED
+#define CpuDispatch_hpp_INCLUDED
+
+#include <atomic>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PRNG_CPU_DISPATCH 1
+#endif
+
+namespace PRNG {
+
+/*
+ * Runtime dispatch of the block kernels
+ *
+ * The kernels (the next_n() loops, the conversion loops of fill, fillRange
+ * and fillNormal, jump matrix and polynomial products) are plain C++ left to
+ * the vectorizer. runKernel(f) compiles f once per instruction set level:
+ * its body is inlined (flatten) into instantiations with target("avx2") and
+ * target("avx512..."), and the level is chosen by a cpuid check done once.
+ * A binary built for baseline x86-64 thus uses AVX2 or AVX-512 where the
+ * CPU has them, and runs on CPUs without.
+ *
+ * All levels give bit-identical results. Integer kernels do so trivially.
+ * Floating point kernels (runKernel<true>) stop at AVX2, which has no FMA,
+ * so no multiply-add is contracted unlike the baseline code.
+ *
+ * Other compilers and architectures run the kernels as compiled.
+ */
+enum class SimdLevel: int { Baseline = 0, AVX2 = 1, AVX512 = 2 };
+
+inline SimdLevel detectSimdLevel() {
+#ifdef PRNG_CPU_DISPATCH
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+       __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq")) return SimdLevel::AVX512;
+    if(__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+    return SimdLevel::Baseline;
+}
+
+inline std::atomic<int>& simdLevelStorage() {
+    static std::atomic<int> level((int)detectSimdLevel());
+    return level;
+}
+
+/* The level the kernels run at. */
+inline SimdLevel simdLevel() {
+    return (SimdLevel)simdLevelStorage().load(std::memory_order_relaxed);
+}
+
+/* Restricts the kernels to level (at most the detected one), e.g. to
+   compare the levels; returns the level in effect before. */
+inline SimdLevel setSimdLevel(SimdLevel level) {
+    const SimdLevel detected = detectSimdLevel();
+    if((int)level > (int)detected) level = detected;
+    return (SimdLevel)simdLevelStorage().exchange((int)level, std::memory_order_relaxed);
+}
+
+#ifdef PRNG_CPU_DISPATCH
+template<typename F>
+__attribute__((flatten, target("avx2")))
+void runKernelAVX2(F& f) {
+    f();
+}
+template<typename F>
+__attribute__((flatten, target("avx2,avx512f,avx512bw,avx512vl,avx512dq")))
+void runKernelAVX512(F& f) {
+    f();
+}
+#endif
+
+template<bool FloatingPoint = false, typename F>
+inline void runKernel(F&& f) {
+#ifdef PRNG_CPU_DISPATCH
+    const SimdLevel level = simdLevel();
+    if(level == SimdLevel::AVX512 && !FloatingPoint) {
+        runKernelAVX512(f);
+        return;
+    }
+    if(level != SimdLevel::Baseline) {
+        runKernelAVX2(f);
+        return;
+    }
+#endif
+    f();
+}
+
+}
+
+#endif // CpuDispatch_hpp_INCLUDED
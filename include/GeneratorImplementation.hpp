@@ -1,6 +1,9 @@
 #ifndef GeneratorImplementation_hpp_INCLUDED
 #define GeneratorImplementation_hpp_INCLUDED
 
+#include <cstddef>
+#include "JumpAhead.hpp"
+
 namespace PRNG {
 
     template<typename Derived, bool jumpAble>
@@ -11,6 +14,15 @@ namespace PRNG {
         inline void jump() {
             getDerived().jump();
         }
+        /* Equivalent to k calls of jump(), see JumpAhead. Generators that are
+           not F2-linear (or not plain) provide their own jumpAhead(). */
+        inline void jumpAhead(JumpIndex k) {
+            JumpAhead<Derived>::jump(getDerived(), k);
+        }
+        /* Equivalent to n calls of next(), in O(log n) polynomial products. */
+        inline void discard(JumpIndex n) {
+            JumpAhead<Derived>::discard(getDerived(), n);
+        }
         inline Derived& getDerived() {
             return static_cast<Derived&>(*this);
         }
@@ -32,10 +44,24 @@ namespace PRNG {
             return getDerived().next();
         }
 
+        /* Block generation: writes the next n outputs to out. Implementations
+           provide a specialized kernel (state in registers, unrolled or
+           vectorized loop); this is the scalar fallback. */
+        template<typename UInt>
+        inline void next_n(UInt* out, std::size_t n) {
+            for(std::size_t i=0; i<n; ++i) {
+                out[i] = getDerived().next();
+            }
+        }
+
         inline auto getState() const {
             return getConstDerived().getState();
         }
 
+        /* Number of low output bits of inferior quality (low linear
+           complexity); the bit reservoir of RandomGenerator skips them. */
+        static const unsigned int weakLowBits = 0;
+
         inline Derived& getDerived() {
             return static_cast<Derived&>(*this);
         }
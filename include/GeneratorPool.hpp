@@ -0,0 +1,154 @@
+#ifndef GeneratorPool_hpp_INCLUDED
+#define GeneratorPool_hpp_INCLUDED
+
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <stdexcept>
+#include "RandomGenerators.hpp"
+
+namespace PRNG {
+
+/*
+ * GeneratorPool - one generator per thread, split off a source
+ *
+ * Slot i holds the generator of the (i+1)-th newSource() of the source the
+ * pool was created with, so the stream of thread index i is reproducible and
+ * the same as splitting by hand in index order. Slots are created on first
+ * request (up to capacity) and never move; each occupies its own cache
+ * line(s), so generators of different threads do not share lines.
+ *
+ * local() returns the calling thread's generator: one thread_local lookup
+ * and a compare of the pool id, no locks. The first call of a thread (or the
+ * first after using another pool of the same type) takes a mutex. A thread
+ * gets the lowest index not yet handed out unless it called bind(index)
+ * before; an index belongs to one thread at a time. local() throws
+ * std::out_of_range if all capacity indices are taken.
+ *
+ * get(index) hands out the generator of slot index to any caller; sharing a
+ * slot between threads needs external synchronization.
+ */
+template<typename GenImpl, typename Source = SequenceSplitting<GenImpl,true,Splitmix64> >
+struct GeneratorPool {
+    using Generator = RandomGenerator<GenImpl>;
+    static const std::size_t cacheLine = 64;
+
+    struct alignas(cacheLine) Slot {
+        Generator gen;
+        explicit Slot(Generator&& gen_): gen(std::move(gen_)) {}
+    };
+
+    GeneratorPool(const Source& source, std::size_t capacity):
+        splitter(source),
+        capacity_(capacity),
+        raw(new unsigned char[capacity*sizeof(Slot) + alignof(Slot)]),
+        id(nextPoolId().fetch_add(1) + 1) {
+        void* p = raw.get();
+        std::size_t space = capacity*sizeof(Slot) + alignof(Slot);
+        slots = static_cast<Slot*>(std::align(alignof(Slot), capacity*sizeof(Slot), p, space));
+    }
+    GeneratorPool(const GeneratorPool&) = delete;
+    GeneratorPool& operator=(const GeneratorPool&) = delete;
+
+    ~GeneratorPool() {
+        const std::size_t n = created.load(std::memory_order_acquire);
+        for(std::size_t i=0; i<n; ++i) slots[i].~Slot();
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+    /* Generator of slot index, created together with all slots below it. */
+    Generator& get(std::size_t index) {
+        if(index < created.load(std::memory_order_acquire)) return slots[index].gen;
+        if(index >= capacity_) throw std::out_of_range("GeneratorPool: index exceeds capacity");
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t n = created.load(std::memory_order_relaxed);
+        for(; n <= index; ++n) {
+            new (&slots[n]) Slot(splitter.newSource().getGenerator());
+            created.store(n+1, std::memory_order_release);
+        }
+        return slots[index].gen;
+    }
+
+    /* The calling thread uses slot index from now on and releases the one
+       it held before. Throws std::logic_error if another thread holds
+       index (through bind() or local()). */
+    void bind(std::size_t index) {
+        Generator& gen = get(index);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const std::thread::id self = std::this_thread::get_id();
+            auto it = threadIndex.find(self);
+            const bool own = it != threadIndex.end() && it->second == index;
+            if(!own && taken.count(index))
+                throw std::logic_error("GeneratorPool: index is bound to another thread");
+            if(it != threadIndex.end() && !own) {
+                taken.erase(it->second);
+                if(it->second < nextIndex) nextIndex = it->second;
+            }
+            threadIndex[self] = index;
+            taken.insert(index);
+        }
+        cache() = Cache{ id, &gen };
+    }
+
+    inline Generator& local() {
+        const Cache& c = cache();
+        if(c.pool == id) return *c.gen;
+        return localSlow();
+    }
+
+private:
+    struct Cache {
+        uint64_t   pool;
+        Generator* gen;
+    };
+
+    static Cache& cache() {
+        static thread_local Cache c{ 0, nullptr };
+        return c;
+    }
+
+    static std::atomic<uint64_t>& nextPoolId() {
+        static std::atomic<uint64_t> next(0);
+        return next;
+    }
+
+    Generator& localSlow() {
+        std::size_t index;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = threadIndex.find(std::this_thread::get_id());
+            if(it == threadIndex.end()) {
+                while(taken.count(nextIndex)) ++nextIndex;
+                if(nextIndex >= capacity_) throw std::out_of_range("GeneratorPool: all indices are taken");
+                taken.insert(nextIndex);
+                it = threadIndex.emplace(std::this_thread::get_id(), nextIndex).first;
+            }
+            index = it->second;
+        }
+        Generator& gen = get(index);
+        cache() = Cache{ id, &gen };
+        return gen;
+    }
+
+    Source                                            splitter;
+    const std::size_t                                 capacity_;
+    std::unique_ptr<unsigned char[]>                  raw;
+    Slot*                                             slots;
+    std::atomic<std::size_t>                          created{0};
+    std::mutex                                        mutex;
+    std::unordered_map<std::thread::id, std::size_t>  threadIndex;
+    std::unordered_set<std::size_t>                   taken;
+    std::size_t                                       nextIndex = 0;
+    const uint64_t                                    id;
+};
+
+}
+
+#endif // GeneratorPool_hpp_INCLUDED
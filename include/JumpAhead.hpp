@@ -0,0 +1,366 @@
+#ifndef JumpAhead_hpp_INCLUDED
+#define JumpAhead_hpp_INCLUDED
+
+#include <stdint.h>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <tuple>
+#include "CpuDispatch.hpp"
+
+namespace PRNG {
+
+/* Unsigned 128 bit integer counting jumps, and addressing the nodes of the
+   SequenceSplitting tree. */
+__extension__ typedef unsigned __int128 JumpIndex;
+
+/*
+ * JumpMatrix - a fixed jump polynomial as a table driven linear map
+ *
+ * Column i of the matrix is the jumped unit state e_i; the columns are
+ * combined per nibble of the state, so applying the jump takes N/4 table
+ * lookups and XORs of N bits instead of N calls of next(). Setting up the
+ * table costs N applications of the polynomial and (N/4)*16 states of
+ * memory (32 KB for 256 bit, 512 KB for 1024 bit generators).
+ *
+ * Requires GenImpl(StateType) to continue exactly where getState() left.
+ */
+template<typename GenImpl>
+struct JumpMatrix {
+    using StateType = typename GenImpl::StateType;
+    static const std::size_t words = std::tuple_size<StateType>::value;
+    static const std::size_t bits  = 64*words;
+
+    std::vector<StateType> table;
+
+    explicit JumpMatrix(const StateType& poly): table(bits/4*16) {
+        std::vector<StateType> columns(bits);
+        for(std::size_t i=0; i<bits; ++i) {
+            StateType e{};
+            e[i/64] = UINT64_C(1) << (i%64);
+            GenImpl gen(e);
+            gen.applyJumpPolynomial(poly);
+            columns[i] = gen.getState();
+        }
+        for(std::size_t c=0; c<bits/4; ++c) {
+            StateType* t = &table[c*16];
+            t[0].fill(0);
+            for(unsigned int v=1; v<16; ++v) {
+                const unsigned int low = v & (0u-v);
+                unsigned int b = 0;
+                while(!((low >> b) & 1)) ++b;
+                for(std::size_t w=0; w<words; ++w) t[v][w] = t[v^low][w] ^ columns[4*c+b][w];
+            }
+        }
+    }
+
+    StateType apply(const StateType& s) const {
+        StateType r{};
+        runKernel([&]() {
+            for(std::size_t w=0; w<words; ++w) {
+                const uint64_t x = s[w];
+                const StateType* t = &table[w*16*16];
+                for(unsigned int n=0; n<16; ++n, t+=16) {
+                    const StateType& col = t[(x >> (4*n)) & 15];
+                    for(std::size_t i=0; i<words; ++i) r[i] ^= col[i];
+                }
+            }
+        });
+        return r;
+    }
+
+    void apply(GenImpl& gen) const {
+        gen = GenImpl(apply(gen.getState()));
+    }
+};
+
+/*
+ * Jump ahead for F2-linear generators
+ *
+ * The state transition T of an F2-linear generator with N bits of state
+ * satisfies its characteristic polynomial P of degree N. Thus advancing by k
+ * steps is the same as applying the polynomial x^k mod P:
+ *
+ *      q(x) = x^k mod P = sum_b q_b x^b      =>      T^k(s) = sum_b q_b T^b(s)
+ *
+ * which is exactly what the reference jump() functions do with their JUMP
+ * constant (JUMP = x^J mod P for the jump distance J, e.g. J=2^128).
+ *
+ * P is recovered once per generator type with Berlekamp-Massey from the
+ * generator itself. The powers x^(2^j J) and x^(2^j) mod P, j<128, are
+ * precomputed, so jumping k*J steps or discarding n outputs costs popcount(k)
+ * (popcount(n)) polynomial products modulo P and one application of the
+ * resulting polynomial (N calls of next()), instead of k calls of jump().
+ * Products use 4 bit comb multiplication and byte-wise table reduction.
+ *
+ * The single jump and the long jump are applied through a JumpMatrix.
+ *
+ * Requires GenImpl::jumpPolynomial(), GenImpl::longJumpPolynomial() (the
+ * reference JUMP and LONG_JUMP as StateType) and
+ * GenImpl::applyJumpPolynomial(const StateType&).
+ */
+template<typename GenImpl>
+struct JumpAhead {
+    using StateType = typename GenImpl::StateType;
+    using Poly      = StateType; // polynomial of degree < N, bit b of word b/64 is q_b
+    static const std::size_t words = std::tuple_size<StateType>::value;
+    static const std::size_t bits  = 64*words;
+    using Product   = std::array<uint64_t,2*words>;
+
+    static inline bool bit(const uint64_t* p, std::size_t b) {
+        return (p[b/64] >> (b%64)) & 1;
+    }
+
+    /* dst ^= src * x^shift */
+    static inline void xorShifted(uint64_t* dst, const uint64_t* src, std::size_t srcWords, std::size_t shift) {
+        const std::size_t ws = shift/64;
+        const unsigned int bs = shift%64;
+        if(bs == 0) {
+            for(std::size_t i=0; i<srcWords; ++i) dst[i+ws] ^= src[i];
+        } else {
+            for(std::size_t i=0; i<srcWords; ++i) {
+                dst[i+ws]   ^= src[i] << bs;
+                dst[i+ws+1] ^= src[i] >> (64-bs);
+            }
+        }
+    }
+
+    /* Characteristic polynomial without its leading term x^N. */
+    static const Poly& charPoly() {
+        static const Poly P = berlekampMassey();
+        return P;
+    }
+
+    /* Minimal polynomial of the sequence of state parities (bit 0 of all
+       state words). For the full-period generators in this library this is
+       the characteristic polynomial. */
+    static Poly berlekampMassey() {
+        const std::size_t n = 2*bits;
+        StateType init;
+        uint64_t z = UINT64_C(0x9E3779B97F4A7C15);
+        for(std::size_t i=0; i<words; ++i) {
+            z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+            init[i] = z ^ (z >> 31);
+        }
+        GenImpl gen(init);
+        std::vector<uint8_t> seq(n);
+        for(std::size_t i=0; i<n; ++i) {
+            const auto& state = gen.getState();
+            uint64_t parity = 0;
+            for(std::size_t w=0; w<words; ++w) parity ^= state[w];
+            seq[i] = parity & 1;
+            gen.next();
+        }
+
+        std::vector<uint8_t> C(n+1,0), B(n+1,0), T;
+        C[0] = B[0] = 1;
+        std::size_t L = 0, m = 1;
+        for(std::size_t i=0; i<n; ++i) {
+            uint8_t d = seq[i];
+            for(std::size_t j=1; j<=L; ++j) d ^= C[j] & seq[i-j];
+            if(d == 0) {
+                ++m;
+            } else if(2*L <= i) {
+                T = C;
+                for(std::size_t j=0; j+m<=n; ++j) C[j+m] ^= B[j];
+                L = i+1-L;
+                B = T;
+                m = 1;
+            } else {
+                for(std::size_t j=0; j+m<=n; ++j) C[j+m] ^= B[j];
+                ++m;
+            }
+        }
+
+        // P(x) = x^L C(1/x)
+        Poly P{};
+        for(std::size_t j=0; j<L && j<bits; ++j) {
+            if(C[L-j]) P[j/64] |= UINT64_C(1) << (j%64);
+        }
+        return P;
+    }
+
+    /* Bitwise reduction modulo P, only used to set up reductionTable(). */
+    static Poly reduceBitwise(Product r) {
+        const Poly& P = charPoly();
+        for(std::size_t b=2*bits-1; b>=bits; --b) {
+            if(bit(r.data(),b)) {
+                r[b/64] ^= UINT64_C(1) << (b%64);
+                xorShifted(r.data(), P.data(), words, b-bits);
+            }
+        }
+        Poly res;
+        for(std::size_t i=0; i<words; ++i) res[i] = r[i];
+        return res;
+    }
+
+    /* v(x) x^N mod P for all bytes v */
+    static const std::array<Poly,256>& reductionTable() {
+        static const std::array<Poly,256> table = []() {
+            std::array<Poly,256> t;
+            for(unsigned int v=0; v<256; ++v) {
+                Product r{};
+                r[words] = v;
+                t[v] = reduceBitwise(r);
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    /* Reduction modulo P eight coefficients at a time. */
+    static Poly reduce(Product r) {
+        const std::array<Poly,256>& R = reductionTable();
+        for(std::size_t w=2*words-1; w>=words; --w) {
+            for(int t=7; t>=0; --t) {
+                const unsigned int v = (r[w] >> (8*t)) & 0xff;
+                if(v) {
+                    r[w] ^= uint64_t(v) << (8*t);
+                    xorShifted(r.data(), R[v].data(), words, 64*w + 8*t - bits);
+                }
+            }
+        }
+        Poly res;
+        for(std::size_t i=0; i<words; ++i) res[i] = r[i];
+        return res;
+    }
+
+    /* Comb multiplication with 4 bit windows followed by reduce(), see
+       CpuDispatch.hpp. */
+    static Poly mulmod(const Poly& a, const Poly& b) {
+        Poly res;
+        runKernel([&]() { res = combMulmod(a, b); });
+        return res;
+    }
+
+    static Poly combMulmod(const Poly& a, const Poly& b) {
+        std::array<std::array<uint64_t,words+1>,16> bu;
+        bu[0].fill(0);
+        for(std::size_t i=0; i<words; ++i) bu[1][i] = b[i];
+        bu[1][words] = 0;
+        for(unsigned int u=2; u<16; u*=2) {
+            bu[u][0] = bu[u/2][0] << 1;
+            for(std::size_t i=1; i<=words; ++i) bu[u][i] = (bu[u/2][i] << 1) | (bu[u/2][i-1] >> 63);
+        }
+        for(unsigned int u=3; u<16; ++u) {
+            const unsigned int low = u & (0u-u);
+            if(u == low) continue;
+            for(std::size_t i=0; i<=words; ++i) bu[u][i] = bu[u^low][i] ^ bu[low][i];
+        }
+
+        Product r{};
+        for(int k=15; k>=0; --k) {
+            for(std::size_t i=0; i<words; ++i) {
+                const unsigned int u = (a[i] >> (4*k)) & 15;
+                if(u) {
+                    for(std::size_t j=0; j<=words; ++j) r[i+j] ^= bu[u][j];
+                }
+            }
+            if(k) {
+                for(std::size_t i=2*words-1; i>0; --i) r[i] = (r[i] << 4) | (r[i-1] >> 60);
+                r[0] <<= 4;
+            }
+        }
+        return reduce(r);
+    }
+
+    static Poly one() {
+        Poly p{};
+        p[0] = 1;
+        return p;
+    }
+
+    static Poly power(Poly a, JumpIndex e) {
+        Poly res = one();
+        while(e) {
+            if(e & 1) res = mulmod(res, a);
+            e >>= 1;
+            if(e) a = mulmod(a, a);
+        }
+        return res;
+    }
+
+    /* base^(2^j) for j < 128 */
+    static std::array<Poly,128> squarings(Poly base) {
+        std::array<Poly,128> pw;
+        pw[0] = base;
+        for(std::size_t i=1; i<128; ++i) pw[i] = mulmod(pw[i-1], pw[i-1]);
+        return pw;
+    }
+
+    /* prod_{j: bit j of k set} powers[j] */
+    static Poly product(const std::array<Poly,128>& powers, JumpIndex k) {
+        Poly res = one();
+        bool first = true;
+        for(std::size_t j=0; k; ++j, k >>= 1) {
+            if(k & 1) {
+                res = first ? powers[j] : mulmod(res, powers[j]);
+                first = false;
+            }
+        }
+        return res;
+    }
+
+    /* x^(2^j J) mod P for j < 128 */
+    static const std::array<Poly,128>& jumpPowers() {
+        static const std::array<Poly,128> powers = squarings(GenImpl::jumpPolynomial());
+        return powers;
+    }
+
+    /* x^(2^j) mod P for j < 128 */
+    static const std::array<Poly,128>& stepPowers() {
+        static const std::array<Poly,128> powers = []() {
+            Poly x{};
+            x[0] = 2;
+            return squarings(x);
+        }();
+        return powers;
+    }
+
+    /* x^(k J) mod P */
+    static Poly jumpPolynomial(JumpIndex k) {
+        return product(jumpPowers(), k);
+    }
+
+    /* x^n mod P */
+    static Poly discardPolynomial(JumpIndex n) {
+        return product(stepPowers(), n);
+    }
+
+    static const JumpMatrix<GenImpl>& jumpMatrix() {
+        static const JumpMatrix<GenImpl> matrix(GenImpl::jumpPolynomial());
+        return matrix;
+    }
+
+    static const JumpMatrix<GenImpl>& longJumpMatrix() {
+        static const JumpMatrix<GenImpl> matrix(GenImpl::longJumpPolynomial());
+        return matrix;
+    }
+
+    /* Equivalent to k calls of the reference jump(). */
+    static void jump(GenImpl& gen, JumpIndex k) {
+        if(k == 0) return;
+        if(k == 1) {
+            jumpMatrix().apply(gen);
+            return;
+        }
+        gen.applyJumpPolynomial(jumpPolynomial(k));
+    }
+
+    static void longJump(GenImpl& gen) {
+        longJumpMatrix().apply(gen);
+    }
+
+    /* Equivalent to n calls of next(). */
+    static void discard(GenImpl& gen, JumpIndex n) {
+        if(n < bits) {
+            for(std::size_t i=0; i<n; ++i) gen.next();
+            return;
+        }
+        gen.applyJumpPolynomial(discardPolynomial(n));
+    }
+};
+
+}
+
+#endif // JumpAhead_hpp_INCLUDED
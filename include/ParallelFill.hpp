@@ -0,0 +1,177 @@
+#ifndef ParallelFill_hpp_INCLUDED
+#define ParallelFill_hpp_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <stdexcept>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <type_traits>
+#include "RandomGenerators.hpp"
+
+namespace PRNG {
+
+/*
+ * ThreadPool - fixed set of workers running indexed tasks
+ *
+ * parallelFor(tasks, f) runs f(0) ... f(tasks-1) on the workers and the
+ * calling thread and returns when all tasks are done. Tasks are handed out
+ * through an atomic counter, so their order and assignment to threads is
+ * unspecified. f must not throw. Calls from several threads are serialized;
+ * f must not call parallelFor on the same pool.
+ */
+struct ThreadPool {
+    explicit ThreadPool(unsigned int threads) {
+        for(unsigned int i=0; i<threads; ++i) workers.emplace_back([this]() { work(); });
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for(auto& w : workers) w.join();
+    }
+
+    /* Number of threads taking part in parallelFor, the caller included. */
+    unsigned int size() const {
+        return workers.size() + 1;
+    }
+
+    template<typename F>
+    void parallelFor(std::size_t tasks, F f) {
+        std::lock_guard<std::mutex> call(callMutex);
+        std::unique_lock<std::mutex> lock(mutex);
+        job = f;
+        taskCount = tasks;
+        nextTask = 0;
+        active = workers.size();
+        ++generation;
+        lock.unlock();
+        wake.notify_all();
+
+        runTasks();
+
+        lock.lock();
+        done.wait(lock, [this]() { return active == 0; });
+        job = nullptr;
+    }
+
+private:
+    void runTasks() {
+        for(std::size_t t = nextTask++; t < taskCount; t = nextTask++) job(t);
+    }
+
+    void work() {
+        uint64_t seen = 0;
+        for(;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&]() { return stop || generation != seen; });
+                if(stop) return;
+                seen = generation;
+            }
+            runTasks();
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--active == 0) done.notify_one();
+        }
+    }
+
+    std::vector<std::thread>         workers;
+    std::mutex                       callMutex;
+    std::mutex                       mutex;
+    std::condition_variable          wake;
+    std::condition_variable          done;
+    std::function<void(std::size_t)> job;
+    std::size_t                      taskCount = 0;
+    std::atomic<std::size_t>         nextTask{0};
+    std::size_t                      active = 0;
+    uint64_t                         generation = 0;
+    bool                             stop = false;
+};
+
+
+/*
+ * Parallel fill - output independent of the number of threads
+ *
+ * The output is split into logical chunks of chunkSize values which are
+ * filled independently from the generator of the source:
+ *
+ *  parallelFill       chunk c starts at output c*chunkSize (discard()), so
+ *                     the result equals source.getGenerator().fill(u, size).
+ *  parallelFillRange, chunk c is the c-th jump() subsequence of the source
+ *  parallelFillNormal (these draw a variable number of outputs per value).
+ *
+ * The ThreadPool overloads reuse the pool's workers; the others start
+ * threads-1 workers for the call. A chunkSize of 0 throws
+ * std::invalid_argument.
+ */
+static const std::size_t parallelChunkSize = std::size_t(1) << 20;
+
+template<typename Source, typename F>
+void parallelChunks(Source& source, ThreadPool& pool, std::size_t size, std::size_t chunkSize, F fillChunk) {
+    if(chunkSize == 0) throw std::invalid_argument("parallelFill: chunkSize has to be positive");
+    const auto root = source.getGenerator();
+    const std::size_t chunks = (size + chunkSize - 1) / chunkSize;
+    pool.parallelFor(chunks, [&](std::size_t c) {
+        auto gen = root;
+        const std::size_t offset = c * chunkSize;
+        fillChunk(gen, c, offset, (size - offset < chunkSize) ? size - offset : chunkSize);
+    });
+}
+
+template<typename Source, typename T>
+void parallelFill(Source& source, T* u, std::size_t size, ThreadPool& pool,
+                  std::size_t chunkSize = parallelChunkSize) {
+    static_assert(std::is_arithmetic<T>::value, "parallelFill requires arithmetic values.");
+    parallelChunks(source, pool, size, chunkSize, [u](auto& gen, std::size_t, std::size_t offset, std::size_t n) {
+        gen.discard(offset);
+        gen.fill(u + offset, n);
+    });
+}
+template<typename Source, typename T>
+void parallelFill(Source& source, T* u, std::size_t size, unsigned int threads,
+                  std::size_t chunkSize = parallelChunkSize) {
+    ThreadPool pool(threads > 1 ? threads - 1 : 0);
+    parallelFill(source, u, size, pool, chunkSize);
+}
+
+template<typename Source, typename T>
+void parallelFillRange(Source& source, T* u, std::size_t size, T start, T end, ThreadPool& pool,
+                       std::size_t chunkSize = parallelChunkSize) {
+    parallelChunks(source, pool, size, chunkSize, [=](auto& gen, std::size_t c, std::size_t offset, std::size_t n) {
+        gen.jumpAhead(c);
+        gen.fillRange(u + offset, n, start, end);
+    });
+}
+template<typename Source, typename T>
+void parallelFillRange(Source& source, T* u, std::size_t size, T start, T end, unsigned int threads,
+                       std::size_t chunkSize = parallelChunkSize) {
+    ThreadPool pool(threads > 1 ? threads - 1 : 0);
+    parallelFillRange(source, u, size, start, end, pool, chunkSize);
+}
+
+template<typename Source, typename T>
+void parallelFillNormal(Source& source, T* u, std::size_t size, T mu, T sigma, ThreadPool& pool,
+                        std::size_t chunkSize = parallelChunkSize) {
+    parallelChunks(source, pool, size, chunkSize, [=](auto& gen, std::size_t c, std::size_t offset, std::size_t n) {
+        gen.jumpAhead(c);
+        gen.fillNormal(u + offset, n, mu, sigma);
+    });
+}
+template<typename Source, typename T>
+void parallelFillNormal(Source& source, T* u, std::size_t size, T mu, T sigma, unsigned int threads,
+                        std::size_t chunkSize = parallelChunkSize) {
+    ThreadPool pool(threads > 1 ? threads - 1 : 0);
+    parallelFillNormal(source, u, size, mu, sigma, pool, chunkSize);
+}
+
+}
+
+#endif // ParallelFill_hpp_INCLUDED
@@ -0,0 +1,185 @@
+#ifndef philox4x32_hpp_INCLUDED
+#define philox4x32_hpp_INCLUDED
+
+// Philox4x32-10 of Random123, http://www.thesalmons.org/john/random123/
+/*  J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, "Parallel random
+    numbers: as easy as 1, 2, 3", SC '11, doi:10.1145/2063384.2063405 */
+
+#include <stdint.h>
+#include <cstddef>
+#include <array>
+#include "GeneratorImplementation.hpp"
+
+namespace PRNG {
+
+/* A counter-based generator: output n is a bijection (10 rounds of
+   multiply/xor with a 64 bit key) of its 128 bit block counter n/2, so it
+   has no recurrence at all. The state is the key and the index n of the next
+   output. at(n), discard(n) and jumpAhead(k) cost one block, independent of
+   n; the blocks of next_n() are computed in independent lanes.
+
+   Period 2^128 outputs per key. jump() advances by 2^64 outputs, so
+   jumpAhead(id) gives work item id its own subsequence of 2^64 outputs
+   without any setup. Passes BigCrush (Salmon et al.). */
+
+struct Philox4x32: public GeneratorImplementation<Philox4x32,true> {
+    using StateType = std::array<uint64_t,3>;   // key, counter low, counter high
+    using IntType   = uint64_t;
+
+    static const uint32_t M0 = 0xD2511F53;
+    static const uint32_t M1 = 0xCD9E8D57;
+    static const uint32_t W0 = 0x9E3779B9;      // key schedule (golden ratio)
+    static const uint32_t W1 = 0xBB67AE85;      // sqrt(3)-1
+    static const unsigned int rounds = 10;
+    static const std::size_t lanes = 4;        // blocks per batch of next_n()
+
+    Philox4x32(StateType state): key(state[0]), counter(state[1] | (JumpIndex(state[2]) << 64)) {
+        load();
+    };
+    Philox4x32(uint64_t key_, JumpIndex counter_ = 0): key(key_), counter(counter_) {
+        load();
+    };
+
+    uint64_t  key;
+    JumpIndex counter;  // index of the next output
+    uint64_t  odd;      // output counter if counter is odd (second half of its block)
+
+    StateType getState() const {
+        return {{ key, (uint64_t)counter, (uint64_t)(counter >> 64) }};
+    }
+
+    static inline void round(uint32_t& x0, uint32_t& x1, uint32_t& x2, uint32_t& x3, uint32_t k0, uint32_t k1) {
+        const uint64_t p0 = (uint64_t)M0 * x0;
+        const uint64_t p1 = (uint64_t)M1 * x2;
+        x0 = (uint32_t)(p1 >> 32) ^ x1 ^ k0;
+        x1 = (uint32_t)p1;
+        x2 = (uint32_t)(p0 >> 32) ^ x3 ^ k1;
+        x3 = (uint32_t)p0;
+    }
+
+    /* The block of counter c: outputs 2c (x0,x1) and 2c+1 (x2,x3). */
+    static inline std::array<uint32_t,4> block(uint64_t key, JumpIndex c) {
+        uint32_t x0 = (uint32_t)c, x1 = (uint32_t)(c >> 32), x2 = (uint32_t)(c >> 64), x3 = (uint32_t)(c >> 96);
+        uint32_t k0 = (uint32_t)key, k1 = (uint32_t)(key >> 32);
+        for(unsigned int r = 0; r < rounds; ++r) {
+            round(x0, x1, x2, x3, k0, k1);
+            k0 += W0;
+            k1 += W1;
+        }
+        return {{ x0, x1, x2, x3 }};
+    }
+
+    /* Output n of the stream of key, in O(1). */
+    static inline uint64_t at(uint64_t key, JumpIndex n) {
+        const std::array<uint32_t,4> x = block(key, n >> 1);
+        return (n & 1) ? x[2] | ((uint64_t)x[3] << 32) : x[0] | ((uint64_t)x[1] << 32);
+    }
+    inline uint64_t at(JumpIndex n) const {
+        return at(key, n);
+    }
+
+    inline uint64_t next(void) {
+        if(counter & 1) {
+            ++counter;
+            return odd;
+        }
+        const std::array<uint32_t,4> x = block(key, counter >> 1);
+        odd = x[2] | ((uint64_t)x[3] << 32);
+        ++counter;
+        return x[0] | ((uint64_t)x[1] << 32);
+    }
+
+    /* Whole blocks, lanes at a time: each round is a vertical operation on
+       arrays of x0..x3. The words are kept in 64 bit lanes so the compiler
+       can use packed 32x32->64 bit multiplies (pmuludq). */
+    inline void next_n(uint64_t* out, std::size_t n) {
+        std::size_t i = 0;
+        if(n && (counter & 1)) {
+            out[i++] = odd;
+            ++counter;
+        }
+        const std::size_t blocks = (n - i) / 2;
+        const JumpIndex first = counter >> 1;
+        std::size_t b = 0;
+        for(; b + lanes <= blocks; b += lanes) {
+            const JumpIndex c = first + b;
+            uint64_t* o = out + i + 2*b;
+            if((uint32_t)c > UINT32_MAX - lanes) {
+                // the low counter word wraps inside the batch
+                for(std::size_t l = 0; l < lanes; ++l) {
+                    const std::array<uint32_t,4> x = block(key, c + l);
+                    o[2*l]   = x[0] | ((uint64_t)x[1] << 32);
+                    o[2*l+1] = x[2] | ((uint64_t)x[3] << 32);
+                }
+                continue;
+            }
+            uint64_t x0[lanes], x1[lanes], x2[lanes], x3[lanes];
+            for(std::size_t l = 0; l < lanes; ++l) {
+                x0[l] = (uint32_t)c + l;
+                x1[l] = (uint32_t)(c >> 32);
+                x2[l] = (uint32_t)(c >> 64);
+                x3[l] = (uint32_t)(c >> 96);
+            }
+            uint64_t k0 = (uint32_t)key, k1 = (uint32_t)(key >> 32);
+            // unrolled, the lane arrays stay in registers across rounds
+#pragma GCC unroll 10
+            for(unsigned int r = 0; r < rounds; ++r) {
+                for(std::size_t l = 0; l < lanes; ++l) {
+                    const uint64_t p0 = (uint64_t)M0 * (uint32_t)x0[l];
+                    const uint64_t p1 = (uint64_t)M1 * (uint32_t)x2[l];
+                    const uint64_t y0 = (p1 >> 32) ^ x1[l] ^ k0;
+                    const uint64_t y2 = (p0 >> 32) ^ x3[l] ^ k1;
+                    x1[l] = (uint32_t)p1;
+                    x3[l] = (uint32_t)p0;
+                    x0[l] = y0;
+                    x2[l] = y2;
+                }
+                k0 = (uint32_t)(k0 + W0);
+                k1 = (uint32_t)(k1 + W1);
+            }
+            for(std::size_t l = 0; l < lanes; ++l) {
+                o[2*l]   = x0[l] | (x1[l] << 32);
+                o[2*l+1] = x2[l] | (x3[l] << 32);
+            }
+        }
+        for(; b < blocks; ++b) {
+            const std::array<uint32_t,4> x = block(key, first + b);
+            out[i + 2*b]   = x[0] | ((uint64_t)x[1] << 32);
+            out[i + 2*b+1] = x[2] | ((uint64_t)x[3] << 32);
+        }
+        i += 2*blocks;
+        counter += 2*blocks;
+        if(i < n) out[i] = next();
+    }
+
+    /* Equivalent to n calls of next(), in O(1). */
+    inline void discard(JumpIndex n) {
+        counter += n;
+        load();
+    }
+
+    /* Equivalent to 2^64 calls to next(); 2^64 non-overlapping
+       subsequences. */
+    inline void jump(void) {
+        jumpAhead(1);
+    }
+    /* Equivalent to k calls of jump(), in O(1). */
+    inline void jumpAhead(JumpIndex k) {
+        discard(k << 64);
+    }
+    /* Equivalent to 2^96 calls to next(). */
+    inline void long_jump(void) {
+        discard(JumpIndex(1) << 96);
+    }
+    static const unsigned int jumpIndexBits = 64;
+
+private:
+    /* Recomputes odd when counter points into the middle of a block. */
+    inline void load() {
+        odd = (counter & 1) ? at(counter) : 0;
+    }
+};
+
+}
+
+#endif // philox4x32_hpp_INCLUDED
@@ -5,6 +5,8 @@
 #include <limits>
 #include <type_traits>
 #include <stdint.h>
+#include <cstring>
+#include <cmath>
 #include <iterator>
 #include <vector>
 #include <array>
@@ -15,11 +17,18 @@
 #include "Xoroshiro128plus.hpp"
 #include "Xoshiro256starstar.hpp"
 #include "Xoshiro256plus.hpp"
+#include "Xoshiro256MultiLane.hpp"
+#include "Philox4x32.hpp"
+#include "CpuDispatch.hpp"
+#include "Seeding.hpp"
+#include "Ziggurat.hpp"
+#include "BoundedRange.hpp"
+#include "AliasTable.hpp"
+#include "Shuffle.hpp"
 
 
 namespace PRNG {
 
-// TODO static implementation (i.e. source splitting with template indices...)
 // TODO perservative - non-perservative sources
 // TODO sources with more generator implementations 
 
@@ -34,12 +43,12 @@ template<>
 struct RandomGenImplInitiator<Splitmix64> {
     static inline Splitmix64 init(uint64_t seed) {return Splitmix64(seed);};
     static inline Splitmix64 get(uint64_t seed) {return RandomGenImplInitiator<Splitmix64>::init(seed);};
-    static inline Splitmix64 get() {return RandomGenImplInitiator<Splitmix64>::get(rand());};
+    static inline Splitmix64 get() {return RandomGenImplInitiator<Splitmix64>::get(entropySeed());};
 };
-Splitmix64 splitmix64() {
+inline Splitmix64 splitmix64() {
     return RandomGenImplInitiator<Splitmix64>::get();
 }
-Splitmix64 splitmix64(uint64_t seed) {
+inline Splitmix64 splitmix64(uint64_t seed) {
     return RandomGenImplInitiator<Splitmix64>::get(seed);
 }
 
@@ -63,10 +72,10 @@ struct RandomGenImplInitiator<Xorshift1024star> {
             return __splitmixhelper(splitmix64());
         };
 };
-Xorshift1024star xorshift1024star() {
+inline Xorshift1024star xorshift1024star() {
     return RandomGenImplInitiator<Xorshift1024star>::get();
 }
-Xorshift1024star xorshift1024star(uint64_t seed) {
+inline Xorshift1024star xorshift1024star(uint64_t seed) {
     return RandomGenImplInitiator<Xorshift1024star>::get(seed);
 }
 
@@ -92,10 +101,10 @@ struct RandomGenImplInitiator<Xorshift128plus> {
             return __splitmixhelper(splitmix64());
         };
 };
-Xorshift128plus xorshift128plus() {
+inline Xorshift128plus xorshift128plus() {
     return RandomGenImplInitiator<Xorshift128plus>::get();
 }
-Xorshift128plus xorshift128plus(uint64_t seed) {
+inline Xorshift128plus xorshift128plus(uint64_t seed) {
     return RandomGenImplInitiator<Xorshift128plus>::get(seed);
 }
 
@@ -119,10 +128,10 @@ struct RandomGenImplInitiator<Xoroshiro128plus> {
             return __splitmixhelper(splitmix64());
         };
 };
-Xoroshiro128plus xoroshiro128plus() {
+inline Xoroshiro128plus xoroshiro128plus() {
     return RandomGenImplInitiator<Xoroshiro128plus>::get();
 }
-Xoroshiro128plus xoroshiro128plus(uint64_t seed) {
+inline Xoroshiro128plus xoroshiro128plus(uint64_t seed) {
     return RandomGenImplInitiator<Xoroshiro128plus>::get(seed);
 }
 
@@ -147,10 +156,10 @@ struct RandomGenImplInitiator<Xoshiro256plus> {
             return __splitmixhelper(splitmix64());
         };
 };
-Xoshiro256plus xoshiro256plus() {
+inline Xoshiro256plus xoshiro256plus() {
     return RandomGenImplInitiator<Xoshiro256plus>::get();
 }
-Xoshiro256plus xoshiro256plus(uint64_t seed) {
+inline Xoshiro256plus xoshiro256plus(uint64_t seed) {
     return RandomGenImplInitiator<Xoshiro256plus>::get(seed);
 }
 
@@ -176,14 +185,63 @@ struct RandomGenImplInitiator<Xoshiro256starstar > {
             return __splitmixhelper(splitmix64());
         };
 };
-Xoshiro256starstar xoshiro256starstar() {
+inline Xoshiro256starstar xoshiro256starstar() {
     return RandomGenImplInitiator<Xoshiro256starstar >::get();
 }
-Xoshiro256starstar xoshiro256starstar(uint64_t seed) {
+inline Xoshiro256starstar xoshiro256starstar(uint64_t seed) {
     return RandomGenImplInitiator<Xoshiro256starstar >::get(seed);
 }
 
 
+template<>
+struct RandomGenImplInitiator<Philox4x32> {
+    static inline Philox4x32 init(std::array<uint64_t,3> state) {
+            return Philox4x32(state);
+        };
+    static inline Philox4x32 get(std::array<uint64_t,3> state) {
+            return RandomGenImplInitiator<Philox4x32>::init(state);
+        };
+    /* The key is taken from splitmix64(seed), the counter starts at 0. */
+    static inline Philox4x32 get(uint64_t seed) {
+            return Philox4x32(splitmix64(seed).next());
+        };
+    static inline Philox4x32 get() {
+            return Philox4x32(splitmix64().next());
+        };
+};
+inline Philox4x32 philox4x32() {
+    return RandomGenImplInitiator<Philox4x32>::get();
+}
+inline Philox4x32 philox4x32(uint64_t seed) {
+    return RandomGenImplInitiator<Philox4x32>::get(seed);
+}
+
+
+template<typename Scalar, std::size_t Lanes>
+struct RandomGenImplInitiator<Xoshiro256MultiLane<Scalar,Lanes> > {
+    using GenImpl = Xoshiro256MultiLane<Scalar,Lanes>;
+    static inline GenImpl init(std::array<uint64_t,4> seed) {
+            return GenImpl(seed);
+        };
+    static inline GenImpl get(std::array<uint64_t,4> seed) {
+            return RandomGenImplInitiator<GenImpl>::init(seed);
+        };
+    static inline GenImpl get(typename GenImpl::StateType state) {
+            return GenImpl(state);
+        };
+    static inline GenImpl __splitmixhelper(Splitmix64 sm64) {
+            std::array<uint64_t,4> xorseed;
+            for (unsigned int i=0; i<4;++i) {xorseed[i]=sm64.next();}
+            return GenImpl(xorseed);
+    }
+    static inline GenImpl get(uint64_t seed) {
+            return __splitmixhelper(splitmix64(seed));
+        };
+    static inline GenImpl get() {
+            return __splitmixhelper(splitmix64());
+        };
+};
+
 
 /*
  * Wrapper around GeneratorImplementation with supporting functions
@@ -193,31 +251,55 @@ struct RandomGenerator: GeneratorImpl {
     using Inttype = typename GeneratorImpl::IntType;
     inline Inttype max() const { return std::numeric_limits<Inttype>::max();};
 
-    RandomGenerator(RandomGenerator<GeneratorImpl>&& initiated): GeneratorImpl(std::move(initiated)) {};
+    /* Defaulted, so a RandomGenerator of a trivially copyable implementation
+       is trivially copyable (see StateArena). */
+    RandomGenerator(RandomGenerator<GeneratorImpl>&& initiated) = default;
+    RandomGenerator(const RandomGenerator<GeneratorImpl>& other) = default;
     RandomGenerator(GeneratorImpl&& initiated): GeneratorImpl(std::move(initiated)) {};
-
-    auto& operator=(RandomGenerator<GeneratorImpl>&& moveass) {
-        GeneratorImpl::operator=(std::move(moveass));
-        return *this;
-    }
-    auto& operator=(const RandomGenerator<GeneratorImpl>& ass) {
-        GeneratorImpl::operator=(ass);
-        return *this;
-    }
+    RandomGenerator<GeneratorImpl>& operator=(RandomGenerator<GeneratorImpl>&& moveass) = default;
+    RandomGenerator<GeneratorImpl>& operator=(const RandomGenerator<GeneratorImpl>& ass) = default;
 
     template<typename ...T>
+    struct IsSelf: std::false_type {};
+    template<typename T>
+    struct IsSelf<T>: std::is_same<typename std::decay<T>::type, RandomGenerator<GeneratorImpl> > {};
+
+    template<typename ...T,
+        typename std::enable_if<!IsSelf<T...>::value,int>::type=0 >
     RandomGenerator(T&& ... args): GeneratorImpl(RandomGenImplInitiator<GeneratorImpl>::get(std::forward<T>(args)...)) {}
 
+    /*
+     * Conversion of one raw output to T; shared by the scalar rand<T>() and
+     * the block paths, so both yield identical sequences.
+     *
+     * Floating point values take the upper digits bits of the output (53 for
+     * double, 24 for float) times 2^-digits: uniform on [0,1), exactly
+     * representable, and no division.
+     */
+    template<typename T>
+    struct UnitFloat {
+        static const int bits  = std::numeric_limits<Inttype>::digits;
+        static const int keep  = std::numeric_limits<T>::digits < bits ? std::numeric_limits<T>::digits : bits;
+        static const int shift = bits - keep;
+        static constexpr T scale() { return T(1) / (T(2) * (T)(Inttype(1) << (keep-1))); }
+    };
     template<typename T,
         typename std::enable_if<std::is_floating_point<T>::value,int>::type=0 >
-    T       rand        ()  { return ((T) GeneratorImpl::next())/((T)max());}
+    static inline T convert(Inttype x) { return ((T)(x >> UnitFloat<T>::shift)) * UnitFloat<T>::scale(); }
+    template<typename T,
+        typename std::enable_if<std::is_integral<T>::value,int>::type=0 >
+    static inline T convert(Inttype x) { return x; }
+
+    template<typename T,
+        typename std::enable_if<std::is_floating_point<T>::value,int>::type=0 >
+    T       rand        ()  { return convert<T>(GeneratorImpl::next());}
     float   randFloat   ()  { return rand<float>();};
     double  randDouble  ()  { return rand<double>();};
 
     // TODO, export rand specializations in extern class such that they have to be implemented per Implementation
     template<typename T,
         typename std::enable_if<std::is_integral<T>::value,int>::type=0 >
-    T        rand       ()  { return GeneratorImpl::next();          }
+    T        rand       ()  { return convert<T>(GeneratorImpl::next()); }
     int      randInt    ()  { return rand<int>();     }
     unsigned int randUInt    ()  { return rand<unsigned int>();     }
     long int      randLInt    ()  { return rand<long int>();     }
@@ -231,75 +313,256 @@ struct RandomGenerator: GeneratorImpl {
     uint32_t randUInt32 ()  { return rand<uint32_t>();}
     uint64_t randUInt64 ()  { return rand<uint64_t>();}
 
-    template<typename T>
-    void fill(T* u, unsigned int size) {
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=rand<T>();
+    /*
+     * Bit reservoir
+     *
+     * randBits/randNarrow/randBool read the upper digits-weakLowBits bits of
+     * consecutive outputs as one bit stream, high bits first. A 64 bit output
+     * yields 2x32, 4x16, 8x8 or 64x1 draws (generators with weak low bits
+     * skip those, so draws may straddle two outputs). The reservoir is not
+     * part of the generator state: jump() or getState() do not see it, and
+     * rand<T>() keeps drawing full outputs.
+     */
+    static const unsigned int outputBits    = std::numeric_limits<Inttype>::digits;
+    static const unsigned int reservoirSize = outputBits - GeneratorImpl::weakLowBits;
+
+    Inttype      reservoir     = 0;
+    unsigned int reservoirBits = 0;
+
+    /* The next bits (1 <= bits <= 32) of the stream. */
+    inline Inttype randBits(unsigned int bits) {
+        if(reservoirBits >= bits) {
+            const Inttype v = reservoir >> (outputBits - bits);
+            reservoir <<= bits;
+            reservoirBits -= bits;
+            return v;
         }
+        return refillBits(bits);
+    }
+    template<typename T,
+        typename std::enable_if<(std::is_integral<T>::value && sizeof(T) < sizeof(Inttype)),int>::type=0 >
+    T       randNarrow  ()  { return (T)randBits(8*sizeof(T)); }
+    bool    randBool    ()  { return randBits(1); }
+
+    void clearReservoir() {
+        reservoir = 0;
+        reservoirBits = 0;
+    }
+
+    Inttype refillBits(unsigned int bits) {
+        const unsigned int have = reservoirBits;
+        const unsigned int need = bits - have;
+        const Inttype fresh = GeneratorImpl::next();
+        const Inttype high  = have ? reservoir >> (outputBits - have) : 0;
+        reservoir     = fresh << need;
+        reservoirBits = reservoirSize - need;
+        return (high << need) | (fresh >> (outputBits - need));
+    }
+
+    /*
+     * Block generation
+     *
+     * All fill/randVector/randArray overloads draw blockSize raw outputs at a
+     * time through GeneratorImpl::next_n() and convert them afterwards. The
+     * loops run through runKernel (CpuDispatch.hpp); kernels with floating
+     * point arithmetic, including user modifiers, as floating point kernels.
+     */
+    static const std::size_t blockSize = 256;
+
+    struct Identity {
+        template<typename A>
+        inline A operator()(A a) const { return a; }
+    };
+
+    template<typename T, typename Store, typename F>
+    void fillBlocks(Store store, std::size_t size, F modifier) {
+        const bool floatingPoint = std::is_floating_point<T>::value || !std::is_same<F,Identity>::value;
+        runKernel<floatingPoint>([&]() {
+            Inttype block[blockSize];
+            for(std::size_t offset=0; offset<size; offset+=blockSize) {
+                const std::size_t n = (size-offset < blockSize) ? size-offset : blockSize;
+                GeneratorImpl::next_n(block, n);
+                for(std::size_t i=0; i<n; ++i) {
+                    store(offset+i, modifier(convert<T>(block[i])));
+                }
+            }
+        });
     }
+
     template<typename T, typename F>
-    void fill(T* u, unsigned int size, F modifier) {
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=modifier(rand<T>());
+    void fillPtr(T* u, std::size_t size, F modifier) {
+        fillBlocks<T>([u](std::size_t i, T v) { u[i]=v; }, size, modifier);
+    }
+    template<typename T,
+        typename std::enable_if<std::is_same<T,Inttype>::value,int>::type=0 >
+    void fillPtr(T* u, std::size_t size, Identity) {
+        runKernel([&]() { GeneratorImpl::next_n(u, size); });
+    }
+
+    /*
+     * Bulk kernels for uniform doubles and floats, same values as convert<T>.
+     * There is no packed 64 bit integer to double conversion below AVX-512,
+     * so the 53 bits are split into two halves that are injected as mantissa
+     * into 2^84 and 2^52 and recovered by exact subtractions.
+     */
+    static inline double unitDouble(uint64_t x) {
+        const uint64_t v  = x >> 11;
+        const uint64_t hi = (v >> 32) | UINT64_C(0x4530000000000000);
+        const uint64_t lo = (v & UINT64_C(0xFFFFFFFF)) | UINT64_C(0x4330000000000000);
+        double dhi, dlo;
+        std::memcpy(&dhi, &hi, sizeof(double));
+        std::memcpy(&dlo, &lo, sizeof(double));
+        return ((dhi - 19342813113834066795298816.) + (dlo - 4503599627370496.)) * (1. / 9007199254740992.);
+    }
+    template<typename T,
+        typename std::enable_if<(std::is_same<T,double>::value && std::numeric_limits<Inttype>::digits == 64
+                                 && std::numeric_limits<double>::is_iec559),int>::type=0 >
+    void fillPtr(T* u, std::size_t size, Identity) {
+        runKernel<true>([&]() {
+            Inttype block[blockSize];
+            for(std::size_t offset=0; offset<size; offset+=blockSize) {
+                const std::size_t n = (size-offset < blockSize) ? size-offset : blockSize;
+                GeneratorImpl::next_n(block, n);
+                for(std::size_t i=0; i<n; ++i) u[offset+i] = unitDouble(block[i]);
+            }
+        });
+    }
+    template<typename T,
+        typename std::enable_if<(std::is_same<T,float>::value && std::numeric_limits<Inttype>::digits == 64),int>::type=0 >
+    void fillPtr(T* u, std::size_t size, Identity) {
+        runKernel<true>([&]() {
+            Inttype block[blockSize];
+            for(std::size_t offset=0; offset<size; offset+=blockSize) {
+                const std::size_t n = (size-offset < blockSize) ? size-offset : blockSize;
+                GeneratorImpl::next_n(block, n);
+                for(std::size_t i=0; i<n; ++i) u[offset+i] = (float)(int32_t)(block[i] >> 40) * (1.f / 16777216.f);
+            }
+        });
+    }
+
+    /*
+     * Two floats per output - the upper 24 bits of each 32 bit half scaled
+     * by 2^-24, so the first float is rand<float>() of the output and the
+     * second has the same precision. Half the generator steps of
+     * fill<float>; the lower half skips the weak low bits (at most 8).
+     */
+    static inline std::array<float,2> floatPair(uint64_t x) {
+        return {{ (float)(int32_t)(x >> 40) * (1.f / 16777216.f),
+                  (float)(int32_t)((uint32_t)x >> 8) * (1.f / 16777216.f) }};
+    }
+    std::array<float,2> randFloatPair() {
+        static_assert(std::numeric_limits<Inttype>::digits == 64 && GeneratorImpl::weakLowBits <= 8,
+                      "randFloatPair requires 64 bit outputs.");
+        return floatPair(GeneratorImpl::next());
+    }
+    /* size floats from (size+1)/2 outputs, the values of repeated
+       randFloatPair(); an odd size drops the second float of the last. */
+    void fillFloatPairs(float* u, std::size_t size);
+
+    /*
+     * Dense uniform doubles - the bit stream of the outputs read as a binary
+     * fraction 0.b1b2... rounded down to a double: the exponent is the
+     * position of the first one bit (count leading zeros), the mantissa the
+     * 52 bits after it. Every double in (0,1) comes with the probability of
+     * [d, d+ulp), values below 2^-53 included, and rand<double>() of the
+     * first output is this value rounded down to multiples of 2^-53.
+     * Outputs starting with 12 or more zeros (probability 2^-12) lack
+     * mantissa bits and continue with the following outputs.
+     */
+    static inline double denseDouble(uint64_t x) {
+        // for x >= 2^52: the exponent of the upper half, converted exactly
+        // as in unitDouble, gives the leading zeros without a scalar lzcnt
+        const uint64_t hi = (x >> 32) | UINT64_C(0x4330000000000000);
+        double dhi;
+        std::memcpy(&dhi, &hi, sizeof(double));
+        dhi -= 4503599627370496.;
+        uint64_t e;
+        std::memcpy(&e, &dhi, sizeof(double));
+        e >>= 52;
+        const uint64_t bits = ((e - 32) << 52) | ((x << ((1055 - e) & 63)) >> 12);
+        double d;
+        std::memcpy(&d, &bits, sizeof(double));
+        return d;
+    }
+    template<typename Next>
+    static double denseTail(uint64_t x, Next& next) {
+        int zeros = 0;
+        while(x == 0) {
+            zeros += 64;
+            if(zeros > 1074) return 0.;
+            x = next();
+        }
+        const int lz = __builtin_clzll(x);
+        const int have = 63 - lz;
+        uint64_t m = x << lz << 1;
+        if(have < 52) m |= next() >> have;
+        const int exponent = -(zeros + lz + 1);
+        // a subnormal result keeps fewer mantissa bits; drop the others here
+        // so that ldexp scales exactly instead of rounding to nearest
+        if(exponent < -1022) {
+            const int drop = -1022 - exponent;
+            if(drop > 52) return 0.;
+            m = m >> (12 + drop) << (12 + drop);
         }
+        return std::ldexp(1. + (double)(m >> 12) * (1. / 4503599627370496.), exponent);
+    }
+    double randDoubleDense() {
+        static_assert(std::numeric_limits<Inttype>::digits == 64, "randDoubleDense requires 64 bit outputs.");
+        const uint64_t x = GeneratorImpl::next();
+        if(x >> 52) return denseDouble(x);
+        auto next = [this]() { return GeneratorImpl::next(); };
+        return denseTail(x, next);
+    }
+    /* size values of randDoubleDense(); a block with a short output is
+       redone sequentially, the continuation reading the block first. */
+    void fillDense(double* u, std::size_t size);
+
+    template<typename T>
+    void fill(T* u, std::size_t size);
+    template<typename T, typename F>
+    void fill(T* u, std::size_t size, F modifier) {
+        fillPtr<T>(u, size, modifier);
     }
 
     template<typename T,unsigned int size>
     void fill(T u[size]) {
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=rand<T>();
-        }
+        fillPtr<T>(u, size, Identity());
     }
     template<typename T,unsigned int size, typename F>
     void fill(T u[size], F modifier) {
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=modifier(rand<T>());
-        }
+        fillPtr<T>(u, size, modifier);
     }
 
     template<typename T, typename storage>
-    void fill(storage& u,unsigned int size) {
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=rand<T>();
-        }
+    void fill(storage& u,std::size_t size) {
+        fillBlocks<T>([&u](std::size_t i, T v) { u[i]=v; }, size, Identity());
     }
     template<typename T, typename storage, typename F>
-    void fill(storage& u,unsigned int size, F modifier) {
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=modifier(rand<T>());
-        }
+    void fill(storage& u,std::size_t size, F modifier) {
+        fillBlocks<T>([&u](std::size_t i, T v) { u[i]=v; }, size, modifier);
     }
 
     template<typename T, typename  storage>
     void fill(typename storage::iterator begin, typename storage::const_iterator end) {
-        while(begin!=end) {
-            (*begin)=(rand<T>());
-            begin++;
-        }
+        fill<T,storage>(begin, end, Identity());
     }
     template<typename T, typename  storage, typename F>
     void fill(typename storage::iterator begin, typename storage::const_iterator end, F modifier) {
-        while(begin!=end) {
-            (*begin)=modifier(rand<T>());
-            begin++;
-        }
+        const std::size_t size = std::distance(typename storage::const_iterator(begin), end);
+        fillBlocks<T>([&begin](std::size_t, T v) { (*begin)=v; ++begin; }, size, modifier);
     }
 
 
     template<typename T>
-    std::vector<T> randVector(unsigned int size) {
+    std::vector<T> randVector(std::size_t size) {
         std::vector<T> u(size);
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=(rand<T>());
-        }
+        fillPtr<T>(u.data(), size, Identity());
         return u;
     }
     template<typename T, typename F>
-    std::vector<T> randVector(unsigned int size, F modifier) {
+    std::vector<T> randVector(std::size_t size, F modifier) {
         std::vector<T> u(size);
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=modifier(rand<T>());
-        }
+        fillPtr<T>(u.data(), size, modifier);
         return u;
     }
 
@@ -308,17 +571,13 @@ struct RandomGenerator: GeneratorImpl {
     template<typename T, unsigned int size>
     std::vector<T> randVector() {
         std::vector<T> u(size);
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=(rand<T>());
-        }
+        fillPtr<T>(u.data(), size, Identity());
         return u;
     }
     template<typename T, unsigned int size, typename F>
     std::vector<T> randVector(F modifier) {
         std::vector<T> u(size);
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=modifier(rand<T>());
-        }
+        fillPtr<T>(u.data(), size, modifier);
         return u;
     }
 
@@ -326,17 +585,13 @@ struct RandomGenerator: GeneratorImpl {
     template<typename T, unsigned int size>
     std::array<T,size> randArray() {
         std::array<T,size> u;
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=(rand<T>());
-        }
+        fillPtr<T>(u.data(), size, Identity());
         return u;
     }
     template<typename T, unsigned int size, typename F>
     std::array<T,size> randArray(F modifier) {
         std::array<T,size> u;
-        for(unsigned int i=0; i<size;++i) {
-            u[i]=modifier(rand<T>());
-        }
+        fillPtr<T>(u.data(), size, modifier);
         return u;
     }
 
@@ -359,12 +614,219 @@ struct RandomGenerator: GeneratorImpl {
         return [=](auto&& a) {  return start+a*(end-start);};
     }
 
-    template<typename T>
-    auto randRange(T start, T end) {
+    /*
+     * Uniform in [start,end). Integers are drawn without bias through
+     * BoundedRange, floating point values through rangeModifier.
+     */
+    template<typename T,
+        typename std::enable_if<std::is_integral<T>::value,int>::type=0 >
+    T randRange(T start, T end) {
+        return BoundedRange<T,Inttype>(start,end)([this]() { return GeneratorImpl::next(); });
+    }
+    template<typename T,
+        typename std::enable_if<std::is_floating_point<T>::value,int>::type=0 >
+    T randRange(T start, T end) {
         return rangeModifier(start,end)(rand<T>());
     }
+
+    /*
+     * size values of randRange(start,end) in one go; yields the same sequence
+     * as repeated randRange calls. The threshold is computed once and the
+     * multiply-high of a whole block runs branch-free; only a block that
+     * contains a rejected raw is redone sequentially.
+     */
+    template<typename T,
+        typename std::enable_if<std::is_integral<T>::value,int>::type=0 >
+    void fillRange(T* u, std::size_t size, T start, T end);
+    template<typename T,
+        typename std::enable_if<std::is_floating_point<T>::value,int>::type=0 >
+    void fillRange(T* u, std::size_t size, T start, T end);
+
+    /*
+     * Uniformly random permutation of [first,last), k distinct values of
+     * [0,n). Bounded integers are drawn in batches of several per output;
+     * arrays beyond Shuffle::cacheBlock elements are shuffled cache-blocked
+     * (see Shuffle.hpp).
+     */
+    template<typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last) {
+        static_assert(std::numeric_limits<Inttype>::digits == 64, "shuffle requires 64 bit outputs.");
+        Shuffle::shuffle(static_cast<GeneratorImpl&>(*this), first, last);
+    }
+    template<typename T>
+    void sampleWithoutReplacement(T n, T k, T* out) {
+        static_assert(std::numeric_limits<Inttype>::digits == 64, "sampleWithoutReplacement requires 64 bit outputs.");
+        Shuffle::sample(static_cast<GeneratorImpl&>(*this), n, k, out);
+    }
+
+    struct UnitDouble {
+        inline double operator()(Inttype x) const { return convert<double>(x); }
+    };
+
+    /*
+     * Normal distribution with mean mu and standard deviation sigma
+     * (ziggurat method, see Ziggurat.hpp).
+     */
+    template<typename T=double,
+        typename std::enable_if<std::is_floating_point<T>::value,int>::type=0 >
+    T randNormal(T mu=0, T sigma=1) {
+        static_assert(std::numeric_limits<Inttype>::digits == 64, "randNormal requires 64 bit outputs.");
+        return mu + sigma * (T)Ziggurat::normal(Ziggurat::tables(),
+                                                [this]() { return GeneratorImpl::next(); },
+                                                UnitDouble());
+    }
+
+    /*
+     * size values of randNormal(mu,sigma); yields the same sequence as
+     * repeated randNormal calls. Each block from next_n() runs the table
+     * lookup of the fast path branch-free over chunks of normalChunk raws.
+     * About one chunk in six contains a rejection; it is redone sequentially,
+     * drawing the extra outputs of the slow path from the block before the
+     * generator, and the next chunk starts after the raws consumed.
+     */
+    static const std::size_t normalChunk = 16;
+
+    template<typename T,
+        typename std::enable_if<std::is_floating_point<T>::value,int>::type=0 >
+    void fillNormal(T* u, std::size_t size, T mu=0, T sigma=1);
 };
 
+/*
+ * The block kernels, defined out of the class so that they are not
+ * implicitly inline: with CPPRAND_EXTERN_TEMPLATES a translation unit calls
+ * the instances in libcpprand instead of compiling them.
+ */
+template<typename GeneratorImpl>
+void RandomGenerator<GeneratorImpl>::fillFloatPairs(float* u, std::size_t size) {
+    static_assert(std::numeric_limits<Inttype>::digits == 64 && GeneratorImpl::weakLowBits <= 8,
+                  "fillFloatPairs requires 64 bit outputs.");
+    const std::size_t outputs = (size + 1) / 2;
+    runKernel<true>([&]() {
+        Inttype block[blockSize];
+        for(std::size_t offset=0; offset<outputs; offset+=blockSize) {
+            std::size_t n = (outputs-offset < blockSize) ? outputs-offset : blockSize;
+            GeneratorImpl::next_n(block, n);
+            float* out = u + 2*offset;
+            if(2*(offset+n) > size) {
+                // odd size, the last output gives only its upper float
+                --n;
+                out[2*n] = floatPair(block[n])[0];
+            }
+            for(std::size_t i=0; i<n; ++i) {
+                out[2*i]   = (float)(int32_t)(block[i] >> 40) * (1.f / 16777216.f);
+                out[2*i+1] = (float)(int32_t)((uint32_t)block[i] >> 8) * (1.f / 16777216.f);
+            }
+        }
+    });
+}
+
+template<typename GeneratorImpl>
+void RandomGenerator<GeneratorImpl>::fillDense(double* u, std::size_t size) {
+    static_assert(std::numeric_limits<Inttype>::digits == 64, "fillDense requires 64 bit outputs.");
+    runKernel<true>([&]() {
+        Inttype block[blockSize];
+        std::size_t offset = 0;
+        while(offset < size) {
+            const std::size_t n = (size-offset < blockSize) ? size-offset : blockSize;
+            GeneratorImpl::next_n(block, n);
+            uint64_t shorter = 0;
+            for(std::size_t i=0; i<n; ++i) {
+                u[offset+i] = denseDouble(block[i]);
+                shorter |= ((block[i] >> 52) - 1) >> 63;   // block[i] < 2^52, vectorizable
+            }
+            if(!shorter) {
+                offset += n;
+                continue;
+            }
+            std::size_t k = 0;
+            auto next = [&]() { return k < n ? block[k++] : GeneratorImpl::next(); };
+            while(k < n) {
+                const uint64_t x = block[k++];
+                u[offset++] = (x >> 52) ? denseDouble(x) : denseTail(x, next);
+            }
+        }
+    });
+}
+
+template<typename GeneratorImpl>
+template<typename T>
+void RandomGenerator<GeneratorImpl>::fill(T* u, std::size_t size) {
+    fillPtr<T>(u, size, Identity());
+}
+
+template<typename GeneratorImpl>
+template<typename T,
+    typename std::enable_if<std::is_integral<T>::value,int>::type >
+void RandomGenerator<GeneratorImpl>::fillRange(T* u, std::size_t size, T start, T end) {
+    using Range = BoundedRange<T,Inttype>;
+    const Range range(start,end);
+    const typename Range::Word t = range.threshold();
+    runKernel([&]() {
+        Inttype block[blockSize];
+        std::size_t offset = 0;
+        while(offset < size) {
+            const std::size_t n = (size-offset < blockSize) ? size-offset : blockSize;
+            GeneratorImpl::next_n(block, n);
+            bool rejected = false;
+            for(std::size_t i=0; i<n; ++i) {
+                const typename Range::Wide m = (typename Range::Wide)Range::word(block[i]) * range.span;
+                u[offset+i] = range.map(m);
+                rejected |= ((typename Range::Word)m < t);
+            }
+            if(!rejected) {
+                offset += n;
+                continue;
+            }
+            for(std::size_t i=0; i<n; ++i) {
+                const typename Range::Wide m = (typename Range::Wide)Range::word(block[i]) * range.span;
+                if((typename Range::Word)m >= t) u[offset++] = range.map(m);
+            }
+        }
+    });
+}
+
+template<typename GeneratorImpl>
+template<typename T,
+    typename std::enable_if<std::is_floating_point<T>::value,int>::type >
+void RandomGenerator<GeneratorImpl>::fillRange(T* u, std::size_t size, T start, T end) {
+    fillPtr<T>(u, size, rangeModifier(start,end));
+}
+
+template<typename GeneratorImpl>
+template<typename T,
+    typename std::enable_if<std::is_floating_point<T>::value,int>::type >
+void RandomGenerator<GeneratorImpl>::fillNormal(T* u, std::size_t size, T mu, T sigma) {
+    static_assert(std::numeric_limits<Inttype>::digits == 64, "fillNormal requires 64 bit outputs.");
+    const Ziggurat::Tables& t = Ziggurat::tables();
+    runKernel<true>([&]() {
+        Inttype block[blockSize];
+        std::size_t offset = 0;
+        while(offset < size) {
+            const std::size_t n = (size-offset < blockSize) ? size-offset : blockSize;
+            GeneratorImpl::next_n(block, n);
+            std::size_t k = 0;
+            auto next = [&]() { return k < n ? block[k++] : GeneratorImpl::next(); };
+            while(k < n) {
+                const std::size_t c = (n-k < normalChunk) ? n-k : normalChunk;
+                bool rejected = false;
+                for(std::size_t i=0; i<c; ++i) {
+                    double x;
+                    rejected |= !Ziggurat::fast(t, block[k+i], x);
+                    u[offset+i] = mu + sigma * (T)x;
+                }
+                if(!rejected) {
+                    k += c;
+                    offset += c;
+                    continue;
+                }
+                const std::size_t end = k + c;
+                while(k < end) u[offset++] = mu + sigma * (T)Ziggurat::normal(t, next, UnitDouble());
+            }
+        }
+    });
+}
+
+
 
 /*
  * General Source description
@@ -410,8 +872,8 @@ struct RandomSpacing: RandomSourcePolicy<
     decltype(seedgen.next()) initState;
 
 
-    RandomSpacing(Derived&& other): seedgen(std::move(other.seedgen)), initState(std::move(other.initState)) {};
-    RandomSpacing(const Derived& other): seedgen(other.seedgen), initState(other.initState) {};
+    RandomSpacing(Derived&& other) = default;
+    RandomSpacing(const Derived& other) = default;
 
     template<typename Arg1, typename ...Args,
         typename std::enable_if<!std::is_same<typename std::decay<Arg1>::type, Derived>::value,int>::type=0 >
@@ -502,6 +964,56 @@ Strictly splitting generators from sources allows both and gives freedom to the
 
 Non-perservative generators can always decay to perservative generators by saving initial states and abandon one new created source
 */
+
+/*
+ * SplitTree - direct addressing of the SequenceSplitting tree
+ *
+ * Node k of the tree (root 1, children 2k and 2k+1) owns the subsequence of
+ * the root state after k-1 jumps, which is what the repeated jumps of
+ * newSource() amount to. With JumpAhead these states are computed directly:
+ * advancing a state by k jumps costs popcount(k) polynomial products, so a
+ * split costs O(depth) instead of O(index).
+ *
+ * Node indices are limited to indexBits bits (k*J has to stay within the
+ * period). A source that can not split any further is rebased: its split
+ * state is replaced by a nonlinear scrambling of itself and the numbering
+ * restarts at 1, so trees can be arbitrarily deep.
+ */
+template<typename GenImpl>
+struct SplitTree {
+    using StateType = typename GenImpl::StateType;
+    static const unsigned int indexBits = GenImpl::jumpIndexBits < 128 ? GenImpl::jumpIndexBits : 128;
+
+    static StateType advance(const StateType& state, JumpIndex jumps) {
+        GenImpl gen = RandomGenImplInitiator<GenImpl>::get(state);
+        gen.jumpAhead(jumps);
+        return gen.getState();
+    }
+
+    static StateType nodeState(const StateType& rootState, JumpIndex node) {
+        return advance(rootState, node-1);
+    }
+
+    /* Index of the n-th (n>=1) source split off from node */
+    static constexpr JumpIndex child(JumpIndex node, unsigned int n) {
+        return (node << n) + 1;
+    }
+
+    static constexpr bool canSplit(JumpIndex index) {
+        return index < (JumpIndex(1) << (indexBits-1));
+    }
+
+    /* Also used on the constexpr states of StaticSequenceSplitting. */
+    template<typename State>
+    static constexpr State rebase(const State& state) {
+        State res{};
+        for(std::size_t i=0; i<res.size(); ++i) {
+            res[i] = Splitmix64::mix(state[i] + (i+1)*UINT64_C(0x9E3779B97F4A7C15));
+        }
+        return res;
+    }
+};
+
 template<typename GenImpl=Xorshift1024star, bool perservative=true, typename SeedGenImpl = Splitmix64>
 struct SequenceSplitting: RandomSourcePolicy<
                                     SequenceSplitting<GenImpl>,
@@ -515,37 +1027,45 @@ struct SequenceSplitting<GenImpl, true, SeedGenImpl>: RandomSourcePolicy<
                                     true> {
     using Derived = SequenceSplitting<GenImpl, true, SeedGenImpl>;
     using StateType = typename GenImpl::StateType;
+    using Tree = SplitTree<GenImpl>;
     static_assert(GenImpl::jumpAble,
                   "SequenceSplitting requires a generator supporting jump ahead.");
     StateType   defaultGenInitState;
     StateType   lastState;
-    unsigned int index = 1;
+    JumpIndex   index = 1;
 
-    SequenceSplitting(Derived&& other): defaultGenInitState(std::move(other.defaultGenInitState)), lastState(std::move(other.lastState)), index(other.index) {};
-    SequenceSplitting(const Derived& other): defaultGenInitState(other.defaultGenInitState), lastState(other.lastState), index(other.index) {};
+    SequenceSplitting(Derived&& other) = default;
+    SequenceSplitting(const Derived& other) = default;
+    Derived& operator=(Derived&& other) = default;
+    Derived& operator=(const Derived& other) = default;
 
     template<typename Arg1, typename ...Args,
-        typename std::enable_if<!std::is_same<typename std::decay<Arg1>::type, Derived>::value,int>::type=0 >
+        typename std::enable_if<!std::is_same<typename std::decay<Arg1>::type, Derived>::value &&
+                                !std::is_same<typename std::decay<Arg1>::type, StateType>::value,int>::type=0 >
     SequenceSplitting(Arg1&& arg1, Args&&... args): defaultGenInitState(RandomGenImplInitiator<GenImpl>::get(
                                               (RandomGenImplInitiator<SeedGenImpl>::get(std::forward<Arg1>(arg1),std::forward<Args>(args)...)).next()
                                             ).getState()), lastState(defaultGenInitState) {}
     SequenceSplitting(): defaultGenInitState(RandomGenImplInitiator<GenImpl>::get().getState()), lastState(defaultGenInitState) {}
 
-    void initChild(StateType state, unsigned int index_=1) {
+    /* Source for node `node` of the tree rooted at rootState (see SplitTree). */
+    SequenceSplitting(const StateType& rootState, JumpIndex node=1): defaultGenInitState(Tree::nodeState(rootState,node)), lastState(defaultGenInitState), index(node) {}
+
+    void initChild(StateType state, JumpIndex index_=1) {
         defaultGenInitState = state;
         lastState = state;
         index = index_;
     }
 
     Derived newSource() {
-        Derived source;
-        GenImpl gen = RandomGenImplInitiator<GenImpl>::get(lastState);
-        for(unsigned int i=0;i<index;++i) gen.jump();
-        lastState = gen.getState();
+        if(!Tree::canSplit(index)) {
+            lastState = Tree::rebase(lastState);
+            index = 1;
+        }
+        lastState = Tree::advance(lastState, index);
         index*=2;
-        gen.jump();
-        source.initChild(gen.getState(),index+1);
-        return std::move(source); 
+        Derived source(*this);
+        source.initChild(Tree::advance(lastState, 1),index+1);
+        return source;
     }
     GenImpl getGeneratorImpl() {
         return RandomGenImplInitiator<GenImpl>::get(defaultGenInitState);
@@ -559,41 +1079,94 @@ struct SequenceSplitting<GenImpl, false, SeedGenImpl>: RandomSourcePolicy<
                                     false> {
     using Derived = SequenceSplitting<GenImpl, false, SeedGenImpl>;
     using StateType = typename GenImpl::StateType;
+    using Tree = SplitTree<GenImpl>;
     static_assert(GenImpl::jumpAble,
                   "SequenceSplitting requires a generator supporting jump ahead.");
     StateType   state;
-    unsigned int index = 1;
+    JumpIndex   index = 1;
 
-    SequenceSplitting(Derived&& other): state(std::move(other.state)), index(other.index) {};
-    SequenceSplitting(const Derived& other): state(other.state), index(other.index) {};
+    SequenceSplitting(Derived&& other) = default;
+    SequenceSplitting(const Derived& other) = default;
+    Derived& operator=(Derived&& other) = default;
+    Derived& operator=(const Derived& other) = default;
 
     template<typename Arg1, typename ...Args,
-        typename std::enable_if<!std::is_same<typename std::decay<Arg1>::type, Derived>::value,int>::type=0 >
+        typename std::enable_if<!std::is_same<typename std::decay<Arg1>::type, Derived>::value &&
+                                !std::is_same<typename std::decay<Arg1>::type, StateType>::value,int>::type=0 >
     SequenceSplitting(Arg1&& arg1, Args&&... args): state(RandomGenImplInitiator<GenImpl>::get(
                                               (RandomGenImplInitiator<SeedGenImpl>::get(std::forward<Arg1>(arg1),std::forward<Args>(args)...)).next()
                                             ).getState()) {}
     SequenceSplitting(): state(RandomGenImplInitiator<GenImpl>::get().getState()) {}
 
-    void initChild(StateType state, unsigned int index_=1) {
-        state= state;
+    /* Source for node `node` of the tree rooted at rootState (see SplitTree). */
+    SequenceSplitting(const StateType& rootState, JumpIndex node=1): state(Tree::nodeState(rootState,node)), index(node) {}
+
+    void initChild(StateType state_, JumpIndex index_=1) {
+        state = state_;
         index = index_;
     }
 
     Derived newSource() {
-        Derived source;
-        GenImpl gen = RandomGenImplInitiator<GenImpl>::get(state);
-        for(unsigned int i=0;i<index;++i) gen.jump();
-        state= gen.getState();
+        if(!Tree::canSplit(index)) {
+            state = Tree::rebase(state);
+            index = 1;
+        }
+        state = Tree::advance(state, index);
         index*=2;
-        gen.jump();
-        source.initChild(gen.getState(),index+1);
-        return std::move(source); 
+        Derived source(*this);
+        source.initChild(Tree::advance(state, 1),index+1);
+        return source;
     }
     GenImpl getGeneratorImpl() {
         return RandomGenImplInitiator<GenImpl>::get(state);
     }
 };
 
+
+/*
+ * Explicit instantiations - the common generators and sources, compiled
+ * once into libcpprand
+ *
+ * CPPRAND_INSTANTIATE(extern) declares them, CPPRAND_INSTANTIATE() defines
+ * them (src/cpprand.cpp). Translation units compiled with
+ * CPPRAND_EXTERN_TEMPLATES (set by the cpprand dependency and cpprand.pc)
+ * then emit no code for the out-of-line members and the listed fill
+ * kernels, and link against the library; inlined calls are unaffected.
+ * Without it the headers stay header-only.
+ */
+#define CPPRAND_INSTANTIATE_GENERATOR(EXTERN, GenImpl) \
+    EXTERN template struct RandomGenerator<GenImpl>; \
+    EXTERN template struct RandomSpacing<GenImpl,true,Splitmix64>; \
+    EXTERN template void RandomGenerator<GenImpl>::fill<uint64_t>(uint64_t*, std::size_t); \
+    EXTERN template void RandomGenerator<GenImpl>::fill<uint32_t>(uint32_t*, std::size_t); \
+    EXTERN template void RandomGenerator<GenImpl>::fill<double>(double*, std::size_t); \
+    EXTERN template void RandomGenerator<GenImpl>::fill<float>(float*, std::size_t); \
+    EXTERN template void RandomGenerator<GenImpl>::fillRange<uint32_t>(uint32_t*, std::size_t, uint32_t, uint32_t); \
+    EXTERN template void RandomGenerator<GenImpl>::fillRange<double>(double*, std::size_t, double, double); \
+    EXTERN template void RandomGenerator<GenImpl>::fillNormal<double>(double*, std::size_t, double, double); \
+    EXTERN template void RandomGenerator<GenImpl>::fillNormal<float>(float*, std::size_t, float, float);
+
+#define CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, GenImpl) \
+    CPPRAND_INSTANTIATE_GENERATOR(EXTERN, GenImpl) \
+    EXTERN template struct SequenceSplitting<GenImpl,true,Splitmix64>;
+
+#define CPPRAND_INSTANTIATE(EXTERN) \
+    CPPRAND_INSTANTIATE_GENERATOR(EXTERN, Splitmix64) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Xorshift1024star) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Xorshift128plus) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Xoroshiro128plus) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Xoshiro256plus) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Xoshiro256starstar) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Xoshiro256plusX4) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Xoshiro256plusX8) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Xoshiro256starstarX4) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Xoshiro256starstarX8) \
+    CPPRAND_INSTANTIATE_JUMPABLE(EXTERN, Philox4x32)
+
+#ifdef CPPRAND_EXTERN_TEMPLATES
+CPPRAND_INSTANTIATE(extern)
+#endif
+
 }
 
 #endif // RandomGen_hpp_INCLUDED
@@ -28,10 +28,10 @@ struct RandomGenImplInitiator<Xoshiro256plusSIMDPP> {
             return __splitmixhelper(splitmix64());
         };
 };
-Xoshiro256plusSIMDPP xoshiro256plusSIMDPP() {
+inline Xoshiro256plusSIMDPP xoshiro256plusSIMDPP() {
     return RandomGenImplInitiator<Xoshiro256plusSIMDPP>::get();
 }
-Xoshiro256plusSIMDPP xoshiro256plusSIMDPP(uint64_t seed) {
+inline Xoshiro256plusSIMDPP xoshiro256plusSIMDPP(uint64_t seed) {
     return RandomGenImplInitiator<Xoshiro256plusSIMDPP>::get(seed);
 }
 
@@ -57,10 +57,10 @@ struct RandomGenImplInitiator<Xoshiro256starstarSIMDPP > {
             return __splitmixhelper(splitmix64());
         };
 };
-Xoshiro256starstarSIMDPP xoshiro256starstarSIMDPP() {
+inline Xoshiro256starstarSIMDPP xoshiro256starstarSIMDPP() {
     return RandomGenImplInitiator<Xoshiro256starstarSIMDPP >::get();
 }
-Xoshiro256starstarSIMDPP xoshiro256starstarSIMDPP(uint64_t seed) {
+inline Xoshiro256starstarSIMDPP xoshiro256starstarSIMDPP(uint64_t seed) {
     return RandomGenImplInitiator<Xoshiro256starstarSIMDPP >::get(seed);
 }
 
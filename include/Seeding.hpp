@@ -0,0 +1,191 @@
+#ifndef Seeding_hpp_INCLUDED
+#define Seeding_hpp_INCLUDED
+
+#include <stdint.h>
+#include <cstddef>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <thread>
+#include "CpuDispatch.hpp"
+#include "Philox4x32.hpp"
+#include "Splitmix64.hpp"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define PRNG_SEED_ATFORK 1
+#endif
+#if defined(PRNG_CPU_DISPATCH) && defined(__x86_64__)
+#include <cpuid.h>
+#define PRNG_SEED_RDSEED 1
+#endif
+
+namespace PRNG {
+
+/*
+ * Seeding - 64 bit seeds for unseeded generators and sources
+ *
+ * entropySeed() hands out the outputs of a per thread Philox4x32 stream,
+ * seedBatchSize at a time, without any lock. Its key and counter come from
+ * one getrandom() call (rdseed, or std::random_device, where getrandom() is
+ * missing) every seedReseedInterval seeds, so one syscall seeds tens of
+ * thousands of sources. The key is mixed with the thread id and the time,
+ * so threads get different streams even if the entropy source fails; a
+ * forked child rekeys instead of continuing the stream of its parent.
+ * entropySeeds(out,n) fills n seeds from a freshly keyed stream.
+ *
+ * setEntropySource(EntropySource::Rdseed) prefers the rdseed instruction;
+ * without it, it falls back to getrandom().
+ */
+enum class EntropySource: int { Getrandom = 0, Rdseed = 1 };
+
+static const std::size_t seedBatchSize = 256;
+static const uint64_t seedReseedInterval = uint64_t(1) << 16;
+
+inline std::atomic<int>& entropySourceStorage() {
+    static std::atomic<int> source((int)EntropySource::Getrandom);
+    return source;
+}
+
+/* The entropy source tried first. */
+inline EntropySource entropySource() {
+    return (EntropySource)entropySourceStorage().load(std::memory_order_relaxed);
+}
+
+/* Sets the entropy source tried first; returns the one before. */
+inline EntropySource setEntropySource(EntropySource source) {
+    return (EntropySource)entropySourceStorage().exchange((int)source, std::memory_order_relaxed);
+}
+
+inline bool hasRdseed() {
+#ifdef PRNG_SEED_RDSEED
+    static const bool has = []() {
+        unsigned int a, b, c, d;
+        return __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & (1u << 18));
+    }();
+    return has;
+#else
+    return false;
+#endif
+}
+
+#ifdef PRNG_SEED_RDSEED
+__attribute__((target("rdseed")))
+inline bool rdseedWords(uint64_t* out, std::size_t n) {
+    if(!hasRdseed()) return false;
+    for(std::size_t i=0; i<n; ++i) {
+        unsigned long long x;
+        // rdseed fails while the entropy conditioner refills; give up on
+        // an exhausted one instead of spinning
+        unsigned int tries = 0;
+        while(!__builtin_ia32_rdseed_di_step(&x)) {
+            if(++tries == 1024) return false;
+            __builtin_ia32_pause();
+        }
+        out[i] = x;
+    }
+    return true;
+}
+#else
+inline bool rdseedWords(uint64_t*, std::size_t) {
+    return false;
+}
+#endif
+
+inline bool getrandomWords(uint64_t* out, std::size_t n) {
+#if defined(__linux__) && defined(SYS_getrandom)
+    char* p = reinterpret_cast<char*>(out);
+    std::size_t bytes = n * sizeof(uint64_t);
+    while(bytes > 0) {
+        const long got = syscall(SYS_getrandom, p, bytes, 0);
+        if(got < 0) {
+            if(errno == EINTR) continue;
+            return false;
+        }
+        p += got;
+        bytes -= got;
+    }
+    return true;
+#else
+    (void)out;
+    (void)n;
+    return false;
+#endif
+}
+
+/* n words of system entropy. */
+inline void systemEntropy(uint64_t* out, std::size_t n) {
+    if(entropySource() == EntropySource::Rdseed && rdseedWords(out, n)) return;
+    if(getrandomWords(out, n) || rdseedWords(out, n)) return;
+    std::random_device device;
+    for(std::size_t i=0; i<n; ++i) {
+        out[i] = ((uint64_t)device() << 32) ^ device();
+    }
+}
+
+/* A stream keyed by system entropy, the thread id and the time. */
+inline Philox4x32 seedStream() {
+    uint64_t words[3];
+    systemEntropy(words, 3);
+    const uint64_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+    const uint64_t time = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    return Philox4x32(words[0] ^ Splitmix64::mix(thread ^ Splitmix64::mix(time)), words[1] | (JumpIndex(words[2]) << 64));
+}
+
+/* Incremented in every forked child, which then refills its batches. */
+inline std::atomic<unsigned long>& forkGeneration() {
+    static std::atomic<unsigned long> generation(1);
+#ifdef PRNG_SEED_ATFORK
+    static const bool registered = (pthread_atfork(nullptr, nullptr, []() {
+        forkGeneration().fetch_add(1, std::memory_order_relaxed);
+    }), true);
+    (void)registered;
+#endif
+    return generation;
+}
+
+/* n fresh seeds, from one call of the entropy source. */
+inline void entropySeeds(uint64_t* out, std::size_t n) {
+    Philox4x32 stream = seedStream();
+    runKernel([&]() { stream.next_n(out, n); });
+}
+
+/* A fresh 64 bit seed. */
+inline uint64_t entropySeed() {
+    // zero-initialized, so generation 0 forces the first keying
+    struct Batch {
+        uint64_t      words[seedBatchSize];
+        std::size_t   left;
+        uint64_t      drawn;
+        unsigned long generation;
+        uint64_t      key;
+        JumpIndex     counter;
+    };
+    static thread_local Batch batch;
+    const unsigned long generation = forkGeneration().load(std::memory_order_relaxed);
+    if(batch.left == 0 || batch.generation != generation) {
+        if(batch.generation != generation || batch.drawn >= seedReseedInterval) {
+            const Philox4x32 keyed = seedStream();
+            batch.key = keyed.key;
+            batch.counter = keyed.counter;
+            batch.drawn = 0;
+            batch.generation = generation;
+        }
+        Philox4x32 stream(batch.key, batch.counter);
+        runKernel([&]() { stream.next_n(batch.words, seedBatchSize); });
+        batch.counter = stream.counter;
+        batch.drawn += seedBatchSize;
+        batch.left = seedBatchSize;
+    }
+    return batch.words[--batch.left];
+}
+
+}
+
+#endif // Seeding_hpp_INCLUDED
@@ -0,0 +1,317 @@
+#ifndef Shuffle_hpp_INCLUDED
+#define Shuffle_hpp_INCLUDED
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "CpuDispatch.hpp"
+
+namespace PRNG {
+
+/*
+ * Shuffle - random permutations and samples without replacement
+ *
+ * Bounded integers are drawn in batches (Brackett-Rozinsky & Lemire,
+ * "Batched Ranged Random Integer Generation"): one 64 bit output x yields
+ * values in [0,b_1), ..., [0,b_k) as the high halves of x*b_1, then of the
+ * low half times b_2, and so on, as long as b_1*...*b_k < 2^64. Rejecting
+ * a final low half below 2^64 mod (b_1*...*b_k) makes all k values exactly
+ * uniform. A batch takes k = 64/bits(b_1) bounds, so a Fisher-Yates pass
+ * over 10^9 elements needs half an output per swap, and less than a fifth
+ * once the bounds are below 2^12. Generators with weak low bits batch over
+ * 64-weakLowBits bits, so the last value does not rest on them.
+ *
+ * Outputs are read in blocks from next_n(), but only as many as consumed:
+ * the generator ends up where the same draws with next() would leave it.
+ *
+ * Arrays larger than cacheBlock elements are shuffled cache-blocked
+ * (Sanders, "Random Permutations on Distributed, External and Hierarchical
+ * Memory"): every element draws one of 256 buckets, the array is scattered
+ * into the buckets (256 sequential write streams instead of n random
+ * accesses) and every bucket is shuffled on its own, in cache. As the
+ * buckets are independent uniform choices, the result is a uniform
+ * permutation. The scatter needs a buffer of n elements; an in-place
+ * distribution was slower than plain Fisher-Yates (one unpredictable
+ * branch and dependent load per element). The buffer is uninitialized and
+ * the elements are move-constructed into it, so the value type need not be
+ * default-constructible; types whose moves may throw take plain
+ * Fisher-Yates at any size.
+ */
+struct Shuffle {
+    __extension__ typedef unsigned __int128 Wide;
+
+    static const unsigned int maxBatch   = 8;
+    static const std::size_t  rawBlock   = 256;
+    static const unsigned int buckets    = 256;
+    static const uint64_t     cacheBlock = 1 << 18;
+    /* sample() switches from Floyd's algorithm to a partial shuffle of all
+       n values at k >= n/denseSample. */
+    static const uint64_t     denseSample = 8;
+
+    /* Outputs of gen in blocks; pending is the number still expected. */
+    template<typename Gen>
+    struct RawBlocks {
+        static const unsigned int bits = 64 - Gen::weakLowBits;
+
+        Gen&        gen;
+        uint64_t    pending;
+        std::size_t pos  = 0;
+        std::size_t size = 0;
+        uint64_t    block[rawBlock];
+
+        RawBlocks(Gen& gen_, uint64_t pending_): gen(gen_), pending(pending_) {}
+
+        inline uint64_t operator()() {
+            if(pos == size) refill();
+            return block[pos++];
+        }
+
+        void refill() {
+            size = pending == 0 ? 1 : (pending < rawBlock ? pending : rawBlock);
+            pending -= pending < size ? pending : size;
+            runKernel([&]() { gen.next_n(block, size); });
+            pos = 0;
+        }
+    };
+
+    static inline unsigned int bitLength(uint64_t b) {
+        return 64 - __builtin_clzll(b);
+    }
+
+    /* Batch size for bounds up to b from outputs of the given bits, at most
+       remaining. */
+    static inline unsigned int batchSize(uint64_t b, uint64_t remaining, unsigned int bits) {
+        unsigned int k = bits / bitLength(b);
+        if(k < 1)        k = 1;
+        if(k > maxBatch) k = maxBatch;
+        return remaining < k ? remaining : k;
+    }
+
+    /* out[c] uniform in [0,bound[c]) for c<k, product = bound[0]*...*bound[k-1]. */
+    template<typename Next>
+    static inline void draw(Next& next, const uint64_t* bound, unsigned int k, uint64_t product, uint64_t* out) {
+        uint64_t low = split(next(), bound, k, out);
+        if(low < product) {
+            const uint64_t t = (0 - product) % product;
+            while(low < t) low = split(next(), bound, k, out);
+        }
+    }
+
+    static inline uint64_t split(uint64_t x, const uint64_t* bound, unsigned int k, uint64_t* out) {
+        for(unsigned int c=0; c<k; ++c) {
+            const Wide m = (Wide)x * bound[c];
+            out[c] = (uint64_t)(m >> 64);
+            x = (uint64_t)m;
+        }
+        return x;
+    }
+
+    /* Number of batches of the bounds i, i-1, ..., lo, one per output
+       unless rejected. */
+    static uint64_t batches(uint64_t i, uint64_t lo, unsigned int bits) {
+        uint64_t count = 0;
+        while(i >= lo) {
+            const unsigned int k = batchSize(i, maxBatch, bits);
+            const uint64_t bandLow = std::max<uint64_t>(lo, UINT64_C(1) << (bitLength(i)-1));
+            const uint64_t m = (i - bandLow) / k + 1;
+            count += m;
+            if(m*k > i - lo) break;
+            i -= m*k;
+        }
+        return count;
+    }
+
+    /* Batches of K bounds starting at i >= bandLow, all bounds >= lo. */
+    template<unsigned int K, typename RandomIt, typename Next>
+    static inline uint64_t fisherYatesBand(RandomIt first, uint64_t i, uint64_t bandLow, uint64_t lo, Next& next) {
+        uint64_t bound[K], j[K];
+        while(i >= bandLow && i - lo + 1 >= K) {
+            uint64_t product = 1;
+            for(unsigned int c=0; c<K; ++c) {
+                bound[c] = i - c;
+                product *= i - c;
+            }
+            draw(next, bound, K, product, j);
+            for(unsigned int c=0; c<K; ++c) std::iter_swap(first + (i-1-c), first + j[c]);
+            i -= K;
+        }
+        return i;
+    }
+
+    /*
+     * Fisher-Yates over the positions n-1 down to n-count of first[0,n):
+     * afterwards the last count elements are a uniformly random ordered
+     * sample, count = n-1 shuffles all of them. Each band of equal bit
+     * length runs with a constant batch size.
+     */
+    template<typename RandomIt, typename Next>
+    static void fisherYates(RandomIt first, uint64_t n, uint64_t count, Next& next) {
+        const uint64_t lo = n - count + 1;
+        uint64_t i = n;
+        while(i >= lo) {
+            // k is below the band's batch size only for the last batch
+            const unsigned int k = batchSize(i, i - lo + 1, Next::bits);
+            const uint64_t bandLow = std::max<uint64_t>(lo, UINT64_C(1) << (bitLength(i)-1));
+            switch(k) {
+                case 1:  i = fisherYatesBand<1>(first, i, bandLow, lo, next); break;
+                case 2:  i = fisherYatesBand<2>(first, i, bandLow, lo, next); break;
+                case 3:  i = fisherYatesBand<3>(first, i, bandLow, lo, next); break;
+                case 4:  i = fisherYatesBand<4>(first, i, bandLow, lo, next); break;
+                case 5:  i = fisherYatesBand<5>(first, i, bandLow, lo, next); break;
+                case 6:  i = fisherYatesBand<6>(first, i, bandLow, lo, next); break;
+                case 7:  i = fisherYatesBand<7>(first, i, bandLow, lo, next); break;
+                default: i = fisherYatesBand<8>(first, i, bandLow, lo, next); break;
+            }
+        }
+    }
+
+    template<typename Gen, typename RandomIt>
+    static void shuffleSmall(Gen& gen, RandomIt first, uint64_t n) {
+        if(n < 2) return;
+        RawBlocks<Gen> raw(gen, batches(n, 2, RawBlocks<Gen>::bits));
+        fisherYates(first, n, n-1, raw);
+    }
+
+    /* f(i,c) for the bucket c of each element i<n, drawn from gen. */
+    template<typename Gen, typename F>
+    static inline void bucketIds(Gen& gen, uint64_t n, F&& f) {
+        const unsigned int idsPerRaw = RawBlocks<Gen>::bits / 8;
+        RawBlocks<Gen> raw(gen, (n + idsPerRaw - 1) / idsPerRaw);
+        for(uint64_t i=0; i<n; i+=idsPerRaw) {
+            uint64_t x = raw();
+            const uint64_t c = n-i < idsPerRaw ? n-i : idsPerRaw;
+            for(uint64_t b=0; b<c; ++b) {
+                f(i+b, (unsigned int)(x >> 56));
+                x <<= 8;
+            }
+        }
+    }
+
+    /*
+     * Scatters first[0,n) into buckets in tmp[0,n) and shuffles each bucket
+     * after moving it back. The ids are drawn twice, by a copy of gen for
+     * the bucket sizes and by gen for the scatter, instead of being stored.
+     * tmp is uninitialized storage before and after the call.
+     */
+    template<typename Gen, typename RandomIt, typename T>
+    static void shuffleBlocked(Gen& gen, RandomIt first, T* tmp, uint64_t n, uint64_t block) {
+        uint64_t count[buckets] = {};
+        Gen counter(gen);
+        bucketIds(counter, n, [&](uint64_t, unsigned int c) { ++count[c]; });
+
+        uint64_t head[buckets];
+        uint64_t offset = 0;
+        for(unsigned int c=0; c<buckets; ++c) {
+            head[c] = offset;
+            offset += count[c];
+        }
+        bucketIds(gen, n, [&](uint64_t i, unsigned int c) { ::new((void*)(tmp + head[c]++)) T(std::move(first[i])); });
+
+        uint64_t start = 0;
+        for(unsigned int c=0; c<buckets; ++c) {
+            for(uint64_t i=start; i<start+count[c]; ++i) {
+                first[i] = std::move(tmp[i]);
+                tmp[i].~T();
+            }
+            if(count[c] > block) shuffleBlocked(gen, first + start, tmp + start, count[c], block);
+            else                 shuffleSmall(gen, first + start, count[c]);
+            start += count[c];
+        }
+    }
+
+    /* Uniformly random permutation of [first,last) drawn with gen.next_n(). */
+    template<typename Gen, typename RandomIt>
+    static void shuffle(Gen& gen, RandomIt first, RandomIt last, uint64_t block = cacheBlock) {
+        typedef typename std::iterator_traits<RandomIt>::value_type T;
+        const uint64_t n = std::distance(first, last);
+        // the scatter must not throw between constructing and destroying
+        // the elements in the buffer
+        const bool blocked = std::is_nothrow_move_constructible<T>::value &&
+                             std::is_nothrow_move_assignable<T>::value;
+        if(n <= block || !blocked) {
+            shuffleSmall(gen, first, n);
+            return;
+        }
+        // uninitialized: no pass over the buffer before the scatter
+        struct Release {
+            std::allocator<T>* alloc;
+            uint64_t n;
+            void operator()(T* p) const { alloc->deallocate(p, n); }
+        };
+        std::allocator<T> alloc;
+        std::unique_ptr<T, Release> tmp(alloc.allocate(n), Release{&alloc, n});
+        shuffleBlocked(gen, first, tmp.get(), n, block);
+    }
+
+    /*
+     * k distinct values of [0,n), each k-subset equally likely. Floyd's
+     * algorithm with an open addressing set for small k; the values are
+     * then in no particular order. For k >= n/denseSample the last k
+     * positions of a partial Fisher-Yates shuffle of 0..n-1, which are in
+     * random order.
+     */
+    template<typename Gen, typename T>
+    static void sample(Gen& gen, T n, T k, T* out) {
+        static_assert(std::is_integral<T>::value, "sampleWithoutReplacement requires an integral type.");
+        if(n < 0 || k < 0 || k > n)
+            throw std::invalid_argument("sampleWithoutReplacement: k out of range");
+        const uint64_t un = n;
+        const uint64_t uk = k;
+        if(uk == 0) return;
+
+        if(uk >= un / denseSample) {
+            std::vector<T> values(un);
+            for(uint64_t i=0; i<un; ++i) values[i] = (T)i;
+            RawBlocks<Gen> raw(gen, batches(un, un - uk + 1, RawBlocks<Gen>::bits));
+            fisherYates(values.begin(), un, uk, raw);
+            std::copy(values.end() - uk, values.end(), out);
+            return;
+        }
+
+        // Floyd: for j = n-k..n-1 add t uniform in [0,j], or j if t is taken
+        unsigned int tableBits = 4;
+        while((UINT64_C(1) << tableBits) < 2*uk) ++tableBits;
+        const uint64_t empty = ~UINT64_C(0);
+        std::vector<uint64_t> table(UINT64_C(1) << tableBits, empty);
+        auto insert = [&](uint64_t v) {
+            uint64_t h = (v * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - tableBits);
+            while(table[h] != empty) {
+                if(table[h] == v) return false;
+                h = (h + 1) & (table.size() - 1);
+            }
+            table[h] = v;
+            return true;
+        };
+
+        const unsigned int batch = batchSize(un, maxBatch, RawBlocks<Gen>::bits);
+        RawBlocks<Gen> raw(gen, (uk + batch - 1) / batch);
+        uint64_t bound[maxBatch], t[maxBatch];
+        uint64_t j = un - uk;
+        while(j < un) {
+            const unsigned int b = batchSize(un, un - j, RawBlocks<Gen>::bits);
+            uint64_t product = 1;
+            for(unsigned int c=0; c<b; ++c) {
+                bound[c] = j + c + 1;
+                product *= j + c + 1;
+            }
+            draw(raw, bound, b, product, t);
+            for(unsigned int c=0; c<b; ++c, ++j) {
+                if(insert(t[c])) {
+                    *out++ = (T)t[c];
+                } else {
+                    insert(j);
+                    *out++ = (T)j;
+                }
+            }
+        }
+    }
+};
+
+}
+
+#endif // Shuffle_hpp_INCLUDED
@@ -36,12 +36,37 @@ struct Splitmix64: public GeneratorImplementation<Splitmix64, false> {
         return x;
     }
 
+    /* Equivalent to n calls of next(). */
+    inline void discard(uint64_t n) {
+    	x += n * UINT64_C(0x9E3779B97F4A7C15);
+    }
+
+    /* The output function of next(), a bijective 64 bit mixer. */
+    static constexpr uint64_t mix(uint64_t z) {
+    	z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    	z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    	return z ^ (z >> 31);
+    }
+
     uint64_t next() {
     	uint64_t z = (x += UINT64_C(0x9E3779B97F4A7C15));
     	z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
     	z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
     	return z ^ (z >> 31);
     }
+
+    /* The i-th output only depends on x + i*gamma, so the loop has no carried
+       dependency and vectorizes. */
+    inline void next_n(uint64_t* out, std::size_t n) {
+    	const uint64_t x0 = x;
+    	for(std::size_t i = 0; i < n; ++i) {
+    		uint64_t z = x0 + (i + 1) * UINT64_C(0x9E3779B97F4A7C15);
+    		z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    		z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    		out[i] = z ^ (z >> 31);
+    	}
+    	x = x0 + n * UINT64_C(0x9E3779B97F4A7C15);
+    }
 };
 
 }
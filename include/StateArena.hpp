@@ -0,0 +1,194 @@
+#ifndef StateArena_hpp_INCLUDED
+#define StateArena_hpp_INCLUDED
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <type_traits>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace PRNG {
+
+/*
+ * State file format
+ *
+ * A 64 byte header followed by count records, each the object
+ * representation of T (generator implementations, RandomGenerator,
+ * SequenceSplitting and RandomSpacing are trivially copyable: state words,
+ * position fields like p of Xorshift1024star or the counter of Philox4x32,
+ * the bit reservoir, the node index of a source). The header identifies the
+ * record type (hash of its type name, size, alignment) and the byte order;
+ * a file only opens as the type it was created with, on the same ABI.
+ *
+ * stateFormatVersion is increased whenever the layout of a record type
+ * changes.
+ */
+static const uint32_t stateFormatVersion = 1;
+
+struct StateArenaHeader {
+    char     magic[8];      // "PRNGSTAT"
+    uint32_t version;       // stateFormatVersion
+    uint32_t byteOrder;     // 0x01020304 in the byte order of the writer
+    uint64_t type;          // FNV-1a of the type name of the records
+    uint32_t recordSize;
+    uint32_t recordAlign;
+    uint64_t count;
+    uint64_t reserved[3];
+};
+static_assert(sizeof(StateArenaHeader) == 64, "StateArenaHeader: the header is 64 bytes.");
+
+template<typename T>
+inline uint64_t stateTypeId() {
+    uint64_t h = UINT64_C(0xcbf29ce484222325);
+    for(const char* c = typeid(T).name(); *c; ++c) {
+        h ^= (unsigned char)*c;
+        h *= UINT64_C(0x100000001b3);
+    }
+    return h;
+}
+
+/*
+ * StateArena - array of generators (or sources) living in a mapped file
+ *
+ * The elements are used in place: arena[i].next() advances the state in the
+ * file mapping, sync() writes the dirty pages back (the checkpoint) and
+ * open() maps the file again (the restart), without serializing or parsing
+ * any state. Elements are never copied in or out.
+ *
+ *  auto arena = StateArena<RandomGenerator<Xoshiro256plus> >::create("states", n, gen);
+ *  for(std::size_t i=0; i<n; ++i) arena[i] = source.newSource().getGenerator();
+ *  ... arena[i].randDouble() ...
+ *  arena.sync();
+ *  auto restarted = StateArena<RandomGenerator<Xoshiro256plus> >::open("states");
+ *
+ * Errors of the system calls throw std::system_error, files of another
+ * type or version std::runtime_error.
+ */
+template<typename T>
+struct StateArena {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "StateArena requires trivially copyable elements.");
+    static const std::size_t recordOffset =
+        (sizeof(StateArenaHeader) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    /* Creates (or truncates) path with count copies of value. */
+    static StateArena create(const std::string& path, std::size_t count, const T& value) {
+        StateArena arena;
+        arena.fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if(arena.fd < 0) fail("StateArena: cannot create " + path);
+        arena.length = recordOffset + count * sizeof(T);
+        if(::ftruncate(arena.fd, arena.length) != 0) fail("StateArena: cannot resize " + path);
+        arena.map();
+
+        StateArenaHeader& h = arena.header();
+        std::memcpy(h.magic, "PRNGSTAT", 8);
+        h.version     = stateFormatVersion;
+        h.byteOrder   = 0x01020304;
+        h.type        = stateTypeId<T>();
+        h.recordSize  = sizeof(T);
+        h.recordAlign = alignof(T);
+        h.count       = count;
+        for(std::size_t i=0; i<count; ++i) new (arena.data() + i) T(value);
+        return arena;
+    }
+
+    /* Maps an existing state file of T. */
+    static StateArena open(const std::string& path) {
+        StateArena arena;
+        arena.fd = ::open(path.c_str(), O_RDWR);
+        if(arena.fd < 0) fail("StateArena: cannot open " + path);
+        struct stat st;
+        if(::fstat(arena.fd, &st) != 0) fail("StateArena: cannot stat " + path);
+        arena.length = st.st_size;
+        if(arena.length < recordOffset) throw std::runtime_error("StateArena: " + path + " is not a state file");
+        arena.map();
+
+        const StateArenaHeader& h = arena.header();
+        if(std::memcmp(h.magic, "PRNGSTAT", 8) != 0 || h.byteOrder != 0x01020304)
+            throw std::runtime_error("StateArena: " + path + " is not a state file of this byte order");
+        if(h.version != stateFormatVersion)
+            throw std::runtime_error("StateArena: " + path + " has another format version");
+        if(h.type != stateTypeId<T>() || h.recordSize != sizeof(T) || h.recordAlign != alignof(T))
+            throw std::runtime_error("StateArena: " + path + " holds another state type");
+        if(h.count > (arena.length - recordOffset) / sizeof(T))
+            throw std::runtime_error("StateArena: " + path + " is truncated");
+        return arena;
+    }
+
+    StateArena(StateArena&& other): fd(other.fd), base(other.base), length(other.length) {
+        other.fd = -1;
+        other.base = nullptr;
+    }
+    StateArena& operator=(StateArena&& other) {
+        if(this != &other) {
+            release();
+            fd = other.fd;
+            base = other.base;
+            length = other.length;
+            other.fd = -1;
+            other.base = nullptr;
+        }
+        return *this;
+    }
+    StateArena(const StateArena&) = delete;
+    StateArena& operator=(const StateArena&) = delete;
+
+    ~StateArena() {
+        release();
+    }
+
+    /* Checkpoint: blocks until the states are written to the file. */
+    void sync() {
+        if(::msync(base, length, MS_SYNC) != 0) fail("StateArena: msync failed");
+    }
+
+    std::size_t size() const { return header().count; }
+    T* data() { return reinterpret_cast<T*>(static_cast<char*>(base) + recordOffset); }
+    const T* data() const { return reinterpret_cast<const T*>(static_cast<const char*>(base) + recordOffset); }
+    T& operator[](std::size_t i) { return data()[i]; }
+    const T& operator[](std::size_t i) const { return data()[i]; }
+    T* begin() { return data(); }
+    T* end() { return data() + size(); }
+
+private:
+    StateArena() {}
+
+    static void fail(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void map() {
+        base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(base == MAP_FAILED) {
+            base = nullptr;
+            fail("StateArena: mmap failed");
+        }
+    }
+
+    void release() {
+        if(base) ::munmap(base, length);
+        if(fd >= 0) ::close(fd);
+        base = nullptr;
+        fd = -1;
+    }
+
+    StateArenaHeader& header() { return *static_cast<StateArenaHeader*>(base); }
+    const StateArenaHeader& header() const { return *static_cast<const StateArenaHeader*>(base); }
+
+    int         fd     = -1;
+    void*       base   = nullptr;
+    std::size_t length = 0;
+};
+
+}
+
+#endif // StateArena_hpp_INCLUDED
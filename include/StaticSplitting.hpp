@@ -0,0 +1,289 @@
+#ifndef StaticSplitting_hpp_INCLUDED
+#define StaticSplitting_hpp_INCLUDED
+
+#include <stdint.h>
+#include <cstddef>
+#include <array>
+#include <tuple>
+#include <utility>
+#include "RandomGenerators.hpp"
+
+namespace PRNG {
+
+/* Fixed size state for constant expressions; std::array has no constexpr
+   non-const operator[] before C++17. */
+template<std::size_t N>
+struct StaticWords {
+    uint64_t w[N];
+
+    constexpr uint64_t& operator[](std::size_t i) { return w[i]; }
+    constexpr const uint64_t& operator[](std::size_t i) const { return w[i]; }
+    static constexpr std::size_t size() { return N; }
+};
+
+/*
+ * StaticJumpAhead - the jumps of SplitTree in constant expressions
+ *
+ * The same arithmetic as JumpAhead, written for the constexpr evaluator:
+ * P by Berlekamp-Massey on GenImpl::step(), x^(kJ) mod P as a product of
+ * precomputed squarings (bitwise products), and the application of the
+ * polynomial by GenImpl::step(). Far slower than JumpAhead, but evaluated by
+ * the compiler; P and the squarings once per generator type and
+ * translation unit.
+ *
+ * Requires GenImpl::step(State&) (the state transition of next() on a state
+ * as returned by getState()) and a constexpr GenImpl::jumpPolynomial().
+ */
+template<typename GenImpl>
+struct StaticJumpAhead {
+    using StateType = typename GenImpl::StateType;
+    static const std::size_t words = std::tuple_size<StateType>::value;
+    static const std::size_t bits  = 64*words;
+    using State = StaticWords<words>;
+    using Poly  = State;
+    static_assert(bits <= 256, "StaticJumpAhead: larger states exceed the constexpr budget of the compilers.");
+
+    /* The state of RandomGenImplInitiator<GenImpl>::get(seed). */
+    static constexpr State seed(uint64_t seed) {
+        State s{};
+        for(std::size_t i=0; i<words; ++i) s[i] = Splitmix64::mix(seed + (i+1)*UINT64_C(0x9E3779B97F4A7C15));
+        return s;
+    }
+
+    struct Sequence {
+        uint8_t b[2*bits+1];
+    };
+
+    /* Characteristic polynomial without its leading term x^N, see
+       JumpAhead::berlekampMassey(). */
+    static constexpr Poly charPoly() {
+        const std::size_t n = 2*bits;
+        Sequence seq{}, C{}, B{}, T{};
+        State s = seed(0);
+        for(std::size_t i=0; i<n; ++i) {
+            uint64_t parity = 0;
+            for(std::size_t w=0; w<words; ++w) parity ^= s[w];
+            seq.b[i] = parity & 1;
+            GenImpl::step(s);
+        }
+
+        C.b[0] = B.b[0] = 1;
+        std::size_t L = 0, m = 1;
+        for(std::size_t i=0; i<n; ++i) {
+            uint8_t d = seq.b[i];
+            for(std::size_t j=1; j<=L; ++j) d ^= C.b[j] & seq.b[i-j];
+            if(d == 0) {
+                ++m;
+            } else if(2*L <= i) {
+                T = C;
+                for(std::size_t j=0; j+m<=n; ++j) C.b[j+m] ^= B.b[j];
+                L = i+1-L;
+                B = T;
+                m = 1;
+            } else {
+                for(std::size_t j=0; j+m<=n; ++j) C.b[j+m] ^= B.b[j];
+                ++m;
+            }
+        }
+
+        Poly P{};
+        for(std::size_t j=0; j<L && j<bits; ++j) {
+            if(C.b[L-j]) P[j/64] |= UINT64_C(1) << (j%64);
+        }
+        return P;
+    }
+
+    static constexpr Poly P = charPoly();
+
+    /* a*b mod P, Horner over the bits of a */
+    static constexpr Poly mulmod(const Poly& a, const Poly& b) {
+        Poly r{};
+        for(std::size_t i=bits; i-- > 0;) {
+            const uint64_t top = r.w[words-1] >> 63;
+            for(std::size_t w=words-1; w>0; --w) r.w[w] = (r.w[w] << 1) | (r.w[w-1] >> 63);
+            r.w[0] <<= 1;
+            if(top) {
+                for(std::size_t w=0; w<words; ++w) r.w[w] ^= P.w[w];
+            }
+            if((a.w[i/64] >> (i%64)) & 1) {
+                for(std::size_t w=0; w<words; ++w) r.w[w] ^= b.w[w];
+            }
+        }
+        return r;
+    }
+
+    /* x^(2^j J) mod P for the j < indexBits node indices of SplitTree can have */
+    static const unsigned int indexBits = SplitTree<GenImpl>::indexBits;
+    struct Powers {
+        Poly p[indexBits];
+    };
+    static constexpr Powers squarings() {
+        Powers pw{};
+        const StateType J = GenImpl::jumpPolynomial();
+        for(std::size_t w=0; w<words; ++w) pw.p[0].w[w] = J[w];
+        for(std::size_t j=1; j<indexBits; ++j) pw.p[j] = mulmod(pw.p[j-1], pw.p[j-1]);
+        return pw;
+    }
+
+    static constexpr Powers jumpPowers = squarings();
+
+    /* sum_b q_b next^b(state) */
+    static constexpr State apply(const Poly& q, State s) {
+        State r{};
+        for(std::size_t b=0; b<bits; ++b) {
+            if((q.w[b/64] >> (b%64)) & 1) {
+                for(std::size_t w=0; w<words; ++w) r.w[w] ^= s.w[w];
+            }
+            GenImpl::step(s);
+        }
+        return r;
+    }
+
+    /* Equivalent to k < 2^indexBits calls of jump(): one application of
+       x^(2^j J) per set bit j of k (cheaper here than multiplying them). */
+    static constexpr State advance(State s, JumpIndex k) {
+        for(std::size_t j=0; k; ++j, k >>= 1) {
+            if(k & 1) s = apply(jumpPowers.p[j], s);
+        }
+        return s;
+    }
+};
+template<typename GenImpl>
+constexpr typename StaticJumpAhead<GenImpl>::Powers StaticJumpAhead<GenImpl>::jumpPowers;
+template<typename GenImpl>
+constexpr typename StaticJumpAhead<GenImpl>::Poly StaticJumpAhead<GenImpl>::P;
+
+/* Counter-based: a jump adds 2^64 to the output index. */
+template<>
+struct StaticJumpAhead<Philox4x32> {
+    using StateType = Philox4x32::StateType;
+    static const std::size_t words = 3;
+    using State = StaticWords<words>;
+
+    static constexpr State seed(uint64_t seed) {
+        return State{{ Splitmix64::mix(seed + UINT64_C(0x9E3779B97F4A7C15)), 0, 0 }};
+    }
+
+    static constexpr State advance(const State& s, JumpIndex k) {
+        const JumpIndex counter = (s[1] | (JumpIndex(s[2]) << 64)) + (k << 64);
+        return State{{ s[0], (uint64_t)counter, (uint64_t)(counter >> 64) }};
+    }
+};
+
+
+/*
+ * StaticSequenceSplitting - SequenceSplitting with the splits fixed at compile time
+ *
+ * Path... are the numbers of the newSource() calls leading from the root
+ * source of Seed to this source: <3,1,2> is the second newSource() of the
+ * first newSource() of the third newSource() of
+ * SequenceSplitting<GenImpl,true,Splitmix64>(Seed). The split states
+ * (rebases included) are computed by the compiler, so getGenerator() costs
+ * a copy of a constant state and yields the same generator as the runtime
+ * splits.
+ *
+ * Supports the F2-linear generators with a step() and at most 256 bits of
+ * state (xorshift128+, xoroshiro128+, xoshiro256) and Philox4x32. The
+ * constant evaluation takes about a second per generator type (xoshiro256:
+ * 3s) and grows with the number of splits on the path; paths of several
+ * dozen levels may need a higher -fconstexpr-ops-limit (GCC).
+ */
+template<typename GenImpl, uint64_t Seed, unsigned int... Path>
+struct StaticSequenceSplitting {
+    using StateType = typename GenImpl::StateType;
+    using Jumps     = StaticJumpAhead<GenImpl>;
+    using State     = typename Jumps::State;
+    using Tree      = SplitTree<GenImpl>;
+    static_assert(GenImpl::jumpAble,
+                  "StaticSequenceSplitting requires a generator supporting jump ahead.");
+
+    static constexpr bool validPath() {
+        const unsigned int path[] = { 1u, Path... };
+        for(std::size_t i=1; i<=sizeof...(Path); ++i) {
+            if(path[i] == 0) return false;
+        }
+        return true;
+    }
+
+    /* The source of the n-th newSource() of this one. */
+    template<unsigned int n>
+    using Child = StaticSequenceSplitting<GenImpl, Seed, Path..., n>;
+
+    /* A source as in SequenceSplitting<GenImpl,true>. */
+    struct Node {
+        State     state;
+        State     last;
+        JumpIndex index;
+    };
+
+    static constexpr Node root() {
+        const State s = Jumps::seed(Splitmix64::mix(Seed + UINT64_C(0x9E3779B97F4A7C15)));
+        return Node{ s, s, 1 };
+    }
+
+    /* The n-th newSource() of node. */
+    static constexpr Node split(Node node, unsigned int n) {
+        Node child = node;
+        for(unsigned int i=0; i<n; ++i) {
+            if(!Tree::canSplit(node.index)) {
+                node.last = Tree::rebase(node.last);
+                node.index = 1;
+            }
+            node.last = Jumps::advance(node.last, node.index);
+            node.index *= 2;
+            child.state = Jumps::advance(node.last, 1);
+            child.last  = child.state;
+            child.index = node.index + 1;
+        }
+        return child;
+    }
+
+    static constexpr Node node() {
+        static_assert(validPath(), "StaticSequenceSplitting: newSource() numbers start at 1.");
+        const unsigned int path[] = { 0u, Path... };
+        Node n = root();
+        for(std::size_t i=1; i<=sizeof...(Path); ++i) n = split(n, path[i]);
+        return n;
+    }
+
+    template<std::size_t... I>
+    static constexpr StateType toStateType(const State& s, std::index_sequence<I...>) {
+        return StateType{{ s[I]... }};
+    }
+
+    static constexpr Node      tree      = node();
+    static constexpr StateType initState = toStateType(tree.state, std::make_index_sequence<std::tuple_size<StateType>::value>());
+    static constexpr JumpIndex index     = tree.index;
+
+    static GenImpl getGeneratorImpl() {
+        return RandomGenImplInitiator<GenImpl>::get(initState);
+    }
+
+    /* Generator of this source, or of the source Sub... below it. */
+    template<unsigned int... Sub>
+    static RandomGenerator<GenImpl> getGenerator() {
+        return RandomGenerator<GenImpl>(StaticSequenceSplitting<GenImpl, Seed, Path..., Sub...>::getGeneratorImpl());
+    }
+
+    template<unsigned int n>
+    static Child<n> newSource() {
+        return Child<n>();
+    }
+
+    /* The equivalent runtime source, for further (dynamic) splitting. */
+    static SequenceSplitting<GenImpl,true,Splitmix64> source() {
+        SequenceSplitting<GenImpl,true,Splitmix64> src(initState);
+        src.initChild(initState, index);
+        return src;
+    }
+};
+template<typename GenImpl, uint64_t Seed, unsigned int... Path>
+constexpr typename StaticSequenceSplitting<GenImpl,Seed,Path...>::Node StaticSequenceSplitting<GenImpl,Seed,Path...>::tree;
+template<typename GenImpl, uint64_t Seed, unsigned int... Path>
+constexpr typename GenImpl::StateType StaticSequenceSplitting<GenImpl,Seed,Path...>::initState;
+template<typename GenImpl, uint64_t Seed, unsigned int... Path>
+constexpr JumpIndex StaticSequenceSplitting<GenImpl,Seed,Path...>::index;
+
+}
+
+#endif // StaticSplitting_hpp_INCLUDED
@@ -48,7 +48,7 @@ struct Xoroshiro128plus: public GeneratorImplementation<Xoroshiro128plus,true> {
         return s;
     }
 
-    static inline uint64_t rotl(const uint64_t x, int k) {
+    static constexpr uint64_t rotl(const uint64_t x, int k) {
     	return (x << k) | (x >> (64 - k));
     }
 
@@ -64,21 +64,69 @@ struct Xoroshiro128plus: public GeneratorImplementation<Xoroshiro128plus,true> {
     	return result;
     }
 
+    /* The state transition of next() on any indexable state, usable in
+       constant expressions (see StaticSplitting.hpp). */
+    template<typename State>
+    static constexpr void step(State& s) {
+    	const uint64_t s0 = s[0];
+    	const uint64_t s1 = s[1] ^ s0;
+    	s[0] = rotl(s0, 55) ^ s1 ^ (s1 << 14); // a, b
+    	s[1] = rotl(s1, 36); // c
+    }
+
+    /* next() with the state kept in registers (out may alias s otherwise). */
+    inline void next_n(uint64_t* out, std::size_t n) {
+    	uint64_t s0 = s[0];
+    	uint64_t s1 = s[1];
+    	for(std::size_t i = 0; i < n; ++i) {
+    		out[i] = s0 + s1;
+
+    		s1 ^= s0;
+    		s0 = rotl(s0, 55) ^ s1 ^ (s1 << 14); // a, b
+    		s1 = rotl(s1, 36); // c
+    	}
+    	s[0] = s0;
+    	s[1] = s1;
+    }
+
 
     /* This is the jump function for the generator. It is equivalent
        to 2^64 calls to next(); it can be used to generate 2^64
        non-overlapping subsequences for parallel computations. */
     inline void jump(void) {
-    	static const uint64_t JUMP[] = { 0xbeac0467eba5facb, 0xd86b048b86aa9922 };
+    	JumpAhead<Xoroshiro128plus>::jump(*this, 1);
+    }
+
+    /* This is the long-jump function for the generator. It is equivalent to
+       2^96 calls to next(); it can be used to generate starting points,
+       from each of which jump() generates further non-overlapping
+       subsequences. */
+    inline void long_jump(void) {
+    	JumpAhead<Xoroshiro128plus>::longJump(*this);
+    }
+
+    /* x^(2^96) modulo the characteristic polynomial. */
+    static inline StateType longJumpPolynomial() {
+    	return {{ 0x18f7c399ccebda8d, 0xf2deac28bef3bb07 }};
+    }
+
+    /* x^(2^64) modulo the characteristic polynomial (see JumpAhead.hpp). */
+    static constexpr StateType jumpPolynomial() {
+    	return {{ 0xbeac0467eba5facb, 0xd86b048b86aa9922 }};
+    }
+    static const unsigned int jumpIndexBits = 64;
+    /* The lowest bit is an LFSR. */
+    static const unsigned int weakLowBits = 1;
 
+    /* Replaces the state by sum_b JUMP_b next^b(state). */
+    inline void applyJumpPolynomial(const StateType& JUMP) {
     	uint64_t s0 = 0;
     	uint64_t s1 = 0;
-    	for(unsigned int i = 0; i < sizeof JUMP / sizeof *JUMP; i++)
+    	for(unsigned int i = 0; i < JUMP.size(); i++)
     		for(unsigned int b = 0; b < 64; b++) {
-    			if (JUMP[i] & 1ULL << b) {
-    				s0 ^= s[0];
-    				s1 ^= s[1];
-    			}
+    			const uint64_t mask = UINT64_C(0) - ((JUMP[i] >> b) & 1);
+    			s0 ^= s[0] & mask;
+    			s1 ^= s[1] & mask;
     			next();
     		}
 
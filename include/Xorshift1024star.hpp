@@ -36,8 +36,12 @@ struct Xorshift1024star: public GeneratorImplementation<Xorshift1024star,true> {
     StateType s; 
     int p=15;
 
-    const StateType& getState() const {
-        return s;
+    /* The state rotated such that p=15, i.e. a generator constructed from
+       it continues exactly where this one is. */
+    StateType getState() const {
+        StateType state;
+        for(unsigned int j = 0; j < 16; j++) state[(j + 15) & 15] = s[(j + p) & 15];
+        return state;
     }
 
     inline uint64_t next(void) {
@@ -48,26 +52,73 @@ struct Xorshift1024star: public GeneratorImplementation<Xorshift1024star,true> {
     	return s[p] * UINT64_C(1181783497276652981);
     }
 
+    /* next() on a local copy of the state, so the stores to out do not force
+       reloads of s. */
+    inline void next_n(uint64_t* out, std::size_t n) {
+    	uint64_t t[16];
+    	for(unsigned int j = 0; j < 16; j++) t[j] = s[j];
+    	int q = p;
+    	for(std::size_t i = 0; i < n; ++i) {
+    		const uint64_t s0 = t[q];
+    		uint64_t s1 = t[q = (q + 1) & 15];
+    		s1 ^= s1 << 31; // a
+    		t[q] = s1 ^ s0 ^ (s1 >> 11) ^ (s0 >> 30); // b,c
+    		out[i] = t[q] * UINT64_C(1181783497276652981);
+    	}
+    	for(unsigned int j = 0; j < 16; j++) s[j] = t[j];
+    	p = q;
+    }
+
 
     /* This is the jump function for the generator. It is equivalent
        to 2^512 calls to next(); it can be used to generate 2^512
        non-overlapping subsequences for parallel computations. */
 
     inline void jump(void) {
-    	static const uint64_t JUMP[] = { 0x84242f96eca9c41d,
+    	JumpAhead<Xorshift1024star>::jump(*this, 1);
+    }
+
+    /* Equivalent to 2^768 calls to next(); it can be used to generate
+       starting points, from each of which jump() generates further
+       non-overlapping subsequences. */
+    inline void long_jump(void) {
+    	JumpAhead<Xorshift1024star>::longJump(*this);
+    }
+
+    /* x^(2^768) modulo the characteristic polynomial. */
+    static inline StateType longJumpPolynomial() {
+    	return {{ 0x1db6ba0415e68f80,
+    		0x1f09c81ae9ac14e7, 0x1f6719a6ee34e7f3, 0xc120593b38a9b5ea,
+    		0x3c412a1d4223ae9a, 0x8048b2a10ba2f726, 0x88e5362f50f7f650,
+    		0x891fa8984bfc0276, 0xa19d44b0dd77a638, 0xac0ab6e69c4da928,
+    		0x46719fb5c5c827b7, 0x05dd7bf153461782, 0x56a51dd185004647,
+    		0x59b2257befdad3d3, 0xd5d8a614c24b08b3, 0xd0159f547fca0a39
+    	}};
+    }
+
+    /* x^(2^512) modulo the characteristic polynomial (see JumpAhead.hpp). */
+    static inline StateType jumpPolynomial() {
+    	return {{ 0x84242f96eca9c41d,
     		0xa3c65b8776f96855, 0x5b34a39f070b5837, 0x4489affce4f31a1e,
     		0x2ffeeb0a48316f40, 0xdc2d9891fe68c022, 0x3659132bb12fea70,
     		0xaac17d8efa43cab8, 0xc4cb815590989b13, 0x5ee975283d71c93b,
     		0x691548c86c1bd540, 0x7910c41d10a1e6a5, 0x0b5fc64563b3e2a8,
     		0x047f7684e9fc949d, 0xb99181f2d8f685ca, 0x284600e3f30e38c3
-    	};
+    	}};
+    }
+    static const unsigned int jumpIndexBits = 512;
+    /* The lowest three bits are LFSRs. */
+    static const unsigned int weakLowBits = 3;
 
+    /* Replaces the state by sum_b JUMP_b next^b(state). As the polynomial
+       has 1024 coefficients, p is unchanged. */
+    inline void applyJumpPolynomial(const StateType& JUMP) {
     	uint64_t t[16] = { 0 };
-    	for(unsigned int i = 0; i < sizeof JUMP / sizeof *JUMP; i++)
+    	for(unsigned int i = 0; i < JUMP.size(); i++)
     		for(unsigned int b = 0; b < 64; b++) {
-    			if (JUMP[i] & 1ULL << b)
-    				for(unsigned int j = 0; j < 16; j++)
-    					t[j] ^= s[(j + p) & 15];
+    			const uint64_t mask = UINT64_C(0) - ((JUMP[i] >> b) & 1);
+    			for(unsigned int j = 0; j < 16; j++)
+    				t[j] ^= s[(j + p) & 15] & mask;
     			next();
     		}
 
@@ -59,21 +59,71 @@ struct Xorshift128plus: public GeneratorImplementation<Xorshift128plus,true> {
     	return result; 
     }
 
+    /* The state transition of next() on any indexable state, usable in
+       constant expressions (see StaticSplitting.hpp). */
+    template<typename State>
+    static constexpr void step(State& s) {
+    	uint64_t s1 = s[0];
+    	const uint64_t s0 = s[1];
+    	s[0] = s0;
+    	s1 ^= s1 << 23; // a
+    	s[1] = s1 ^ s0 ^ (s1 >> 18) ^ (s0 >> 5); // b, c
+    }
+
+    /* next() with the state kept in registers (out may alias s otherwise). */
+    inline void next_n(uint64_t* out, std::size_t n) {
+    	uint64_t a = s[0];
+    	uint64_t b = s[1];
+    	for(std::size_t i = 0; i < n; ++i) {
+    		uint64_t s1 = a;
+    		const uint64_t s0 = b;
+    		out[i] = s0 + s1;
+    		a = s0;
+    		s1 ^= s1 << 23; // a
+    		b = s1 ^ s0 ^ (s1 >> 18) ^ (s0 >> 5); // b, c
+    	}
+    	s[0] = a;
+    	s[1] = b;
+    }
+
 
     /* This is the jump function for the generator. It is equivalent
        to 2^64 calls to next(); it can be used to generate 2^64
        non-overlapping subsequences for parallel computations. */
     inline void jump(void) {
-    	static const uint64_t JUMP[] = { 0x8a5cd789635d2dff, 0x121fd2155c472f96 };
+    	JumpAhead<Xorshift128plus>::jump(*this, 1);
+    }
+
+    /* This is the long-jump function for the generator. It is equivalent to
+       2^96 calls to next(); it can be used to generate starting points,
+       from each of which jump() generates further non-overlapping
+       subsequences. */
+    inline void long_jump(void) {
+    	JumpAhead<Xorshift128plus>::longJump(*this);
+    }
+
+    /* x^(2^96) modulo the characteristic polynomial. */
+    static inline StateType longJumpPolynomial() {
+    	return {{ 0xea61c9f1f13962ae, 0xa1fe50ef79cfafb2 }};
+    }
+
+    /* x^(2^64) modulo the characteristic polynomial (see JumpAhead.hpp). */
+    static constexpr StateType jumpPolynomial() {
+    	return {{ 0x8a5cd789635d2dff, 0x121fd2155c472f96 }};
+    }
+    static const unsigned int jumpIndexBits = 64;
+    /* The lowest bit is an LFSR. */
+    static const unsigned int weakLowBits = 1;
 
+    /* Replaces the state by sum_b JUMP_b next^b(state). */
+    inline void applyJumpPolynomial(const StateType& JUMP) {
     	uint64_t s0 = 0;
     	uint64_t s1 = 0;
-    	for(unsigned int i = 0; i < sizeof JUMP / sizeof *JUMP; i++)
+    	for(unsigned int i = 0; i < JUMP.size(); i++)
     		for(unsigned int b = 0; b < 64; b++) {
-    			if (JUMP[i] & 1ULL << b) {
-    				s0 ^= s[0];
-    				s1 ^= s[1];
-    			}
+    			const uint64_t mask = UINT64_C(0) - ((JUMP[i] >> b) & 1);
+    			s0 ^= s[0] & mask;
+    			s1 ^= s[1] & mask;
     			next();
     		}
 
@@ -0,0 +1,213 @@
+#ifndef Xoshiro256MultiLane_hpp_INCLUDED
+#define Xoshiro256MultiLane_hpp_INCLUDED
+
+#include <stdint.h>
+#include <cstddef>
+#include <array>
+#include "GeneratorImplementation.hpp"
+#include "Xoshiro256plus.hpp"
+#include "Xoshiro256starstar.hpp"
+
+namespace PRNG {
+
+/* Output functions of the xoshiro256 family, applied lane-wise by
+   Xoshiro256MultiLane. */
+template<typename Scalar>
+struct Xoshiro256Scrambler {};
+
+template<>
+struct Xoshiro256Scrambler<Xoshiro256plus> {
+    static inline uint64_t apply(const uint64_t s0, const uint64_t, const uint64_t s3) {
+        return s0 + s3;
+    }
+};
+
+template<>
+struct Xoshiro256Scrambler<Xoshiro256starstar> {
+    static inline uint64_t apply(const uint64_t, const uint64_t s1, const uint64_t) {
+        return Xoshiro256starstar::rotl(s1 * 5, 7) * 9;
+    }
+};
+
+
+/* Interleaved xoshiro256 with Lanes independent streams.
+
+   The states are kept in structure-of-arrays layout (word w of lane l is
+   s[w*Lanes+l]), so one step of all lanes is a handful of element-wise
+   operations the compiler maps onto full SIMD registers (Lanes=4 fills an
+   AVX2 register, Lanes=8 an AVX-512 register; build with -march=native or
+   similar).
+
+   Lane 0 is seeded with the given 256 bit state, lane i is lane i-1 after
+   one call of Scalar::jump(), so the lanes are non-overlapping subsequences
+   of the scalar generator. next() returns the outputs lane by lane: the
+   sequence is lane0[0], lane1[0], ..., laneN[0], lane0[1], ...
+
+   jump() moves every lane forward by Lanes scalar jumps, i.e. the jumped
+   generator continues with the next Lanes non-overlapping subsequences.
+   Outputs that are buffered but not yet returned by next() are dropped by
+   jump() and are not part of getState(). */
+
+template<typename Scalar, std::size_t Lanes>
+struct Xoshiro256MultiLane: public GeneratorImplementation<Xoshiro256MultiLane<Scalar,Lanes>,true> {
+    static_assert(Lanes >= 2, "Xoshiro256MultiLane requires at least two lanes.");
+
+    using StateType = std::array<uint64_t,4*Lanes>;
+    using IntType   = uint64_t;
+    static const std::size_t lanes = Lanes;
+
+    Xoshiro256MultiLane(std::array<uint64_t,4> inits) {
+        Scalar gen(inits);
+        setLane(0,gen.getState());
+        for(std::size_t l=1; l<Lanes; ++l) {
+            gen.jump();
+            setLane(l,gen.getState());
+        }
+    };
+    Xoshiro256MultiLane(StateType inits): s(inits) {};
+
+    alignas(64) StateType s;
+    alignas(64) std::array<uint64_t,Lanes> buffer;
+    std::size_t pos = Lanes;
+
+    const StateType& getState() const {
+        return s;
+    }
+
+    std::array<uint64_t,4> getLane(std::size_t l) const {
+        return {{ s[l], s[Lanes+l], s[2*Lanes+l], s[3*Lanes+l] }};
+    }
+
+    void setLane(std::size_t l, const std::array<uint64_t,4>& state) {
+        for(std::size_t w=0; w<4; ++w) s[w*Lanes+l] = state[w];
+    }
+
+    static inline uint64_t rotl(const uint64_t x, int k) {
+    	return (x << k) | (x >> (64 - k));
+    }
+
+    /* Advances all lanes by one step and writes one output per lane to r. */
+    inline void nextLanes(uint64_t* r) {
+    	nextBlocks(r, 1);
+    }
+
+    inline uint64_t next(void) {
+    	if(pos == Lanes) {
+    		nextLanes(buffer.data());
+    		pos = 0;
+    	}
+    	return buffer[pos++];
+    }
+
+    /* Steps all lanes blocks times, writing Lanes outputs per step to r.
+       Works on a local copy of the state so the loop stays in registers. */
+    inline void nextBlocks(uint64_t* r, std::size_t blocks) {
+    	alignas(64) uint64_t s0[Lanes], s1[Lanes], s2[Lanes], s3[Lanes];
+    	for(std::size_t l = 0; l < Lanes; ++l) {
+    		s0[l] = s[l];
+    		s1[l] = s[Lanes+l];
+    		s2[l] = s[2*Lanes+l];
+    		s3[l] = s[3*Lanes+l];
+    	}
+
+    	for(std::size_t b = 0; b < blocks; ++b, r += Lanes) {
+    		for(std::size_t l = 0; l < Lanes; ++l)
+    			r[l] = Xoshiro256Scrambler<Scalar>::apply(s0[l], s1[l], s3[l]);
+
+    		for(std::size_t l = 0; l < Lanes; ++l) {
+    			const uint64_t t = s1[l] << 17;
+
+    			s2[l] ^= s0[l];
+    			s3[l] ^= s1[l];
+    			s1[l] ^= s2[l];
+    			s0[l] ^= s3[l];
+
+    			s2[l] ^= t;
+
+    			s3[l] = rotl(s3[l], 45);
+    		}
+    	}
+
+    	for(std::size_t l = 0; l < Lanes; ++l) {
+    		s[l]         = s0[l];
+    		s[Lanes+l]   = s1[l];
+    		s[2*Lanes+l] = s2[l];
+    		s[3*Lanes+l] = s3[l];
+    	}
+    }
+
+    inline void next_n(uint64_t* out, std::size_t n) {
+    	std::size_t i = 0;
+    	while(pos < Lanes && i < n) out[i++] = buffer[pos++];
+    	const std::size_t blocks = (n - i) / Lanes;
+    	nextBlocks(out + i, blocks);
+    	i += blocks * Lanes;
+    	while(i < n) out[i++] = next();
+    }
+
+
+    /* Equivalent to Lanes calls of Scalar::jump() on every lane. */
+    inline void jump(void) {
+    	Scalar gen(getLane(Lanes-1));
+    	for(std::size_t l=0; l<Lanes; ++l) {
+    		gen.jump();
+    		setLane(l,gen.getState());
+    	}
+    	pos = Lanes;
+    }
+
+    /* Equivalent to k calls of jump(): x^(k Lanes J) is applied to every lane. */
+    inline void jumpAhead(JumpIndex k) {
+    	if(k == 0) return;
+    	const auto poly = JumpAhead<Scalar>::power(JumpAhead<Scalar>::jumpPolynomial(k), Lanes);
+    	for(std::size_t l=0; l<Lanes; ++l) {
+    		Scalar gen(getLane(l));
+    		gen.applyJumpPolynomial(poly);
+    		setLane(l,gen.getState());
+    	}
+    	pos = Lanes;
+    }
+
+    /* Long jump of every lane. */
+    inline void long_jump(void) {
+    	for(std::size_t l=0; l<Lanes; ++l) {
+    		Scalar gen(getLane(l));
+    		gen.long_jump();
+    		setLane(l,gen.getState());
+    	}
+    	pos = Lanes;
+    }
+
+    /* Equivalent to n calls of next(). */
+    inline void discard(JumpIndex n) {
+    	while(pos < Lanes && n) {
+    		++pos;
+    		--n;
+    	}
+    	const JumpIndex steps = n / Lanes;
+    	if(steps) {
+    		const auto poly = JumpAhead<Scalar>::discardPolynomial(steps);
+    		for(std::size_t l=0; l<Lanes; ++l) {
+    			Scalar gen(getLane(l));
+    			gen.applyJumpPolynomial(poly);
+    			setLane(l,gen.getState());
+    		}
+    	}
+    	for(std::size_t i=0; i<n % Lanes; ++i) next();
+    }
+
+    static constexpr unsigned int log2Lanes(std::size_t l = Lanes) {
+    	return l <= 1 ? 0 : 1 + log2Lanes((l + 1) / 2);
+    }
+    static const unsigned int jumpIndexBits = Scalar::jumpIndexBits - log2Lanes();
+    static const unsigned int weakLowBits = Scalar::weakLowBits;
+};
+
+using Xoshiro256plusX4     = Xoshiro256MultiLane<Xoshiro256plus,4>;
+using Xoshiro256plusX8     = Xoshiro256MultiLane<Xoshiro256plus,8>;
+using Xoshiro256starstarX4 = Xoshiro256MultiLane<Xoshiro256starstar,4>;
+using Xoshiro256starstarX8 = Xoshiro256MultiLane<Xoshiro256starstar,8>;
+
+}
+
+#endif // Xoshiro256MultiLane_hpp_INCLUDED
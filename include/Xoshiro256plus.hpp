@@ -44,7 +44,7 @@ struct Xoshiro256plus: public GeneratorImplementation<Xoshiro256plus,true> {
         return s;
     }
 
-    static inline uint64_t rotl(const uint64_t x, int k) {
+    static constexpr uint64_t rotl(const uint64_t x, int k) {
     	return (x << k) | (x >> (64 - k));
     }
 
@@ -66,24 +66,87 @@ struct Xoshiro256plus: public GeneratorImplementation<Xoshiro256plus,true> {
     }
 
 
+    /* The state transition of next() on any indexable state, usable in
+       constant expressions (see StaticSplitting.hpp). */
+    template<typename State>
+    static constexpr void step(State& s) {
+    	const uint64_t t = s[1] << 17;
+    	s[2] ^= s[0];
+    	s[3] ^= s[1];
+    	s[1] ^= s[2];
+    	s[0] ^= s[3];
+    	s[2] ^= t;
+    	s[3] = rotl(s[3], 45);
+    }
+
+    /* next() with the state kept in registers (out may alias s otherwise). */
+    inline void next_n(uint64_t* out, std::size_t n) {
+    	uint64_t s0 = s[0];
+    	uint64_t s1 = s[1];
+    	uint64_t s2 = s[2];
+    	uint64_t s3 = s[3];
+    	for(std::size_t i = 0; i < n; ++i) {
+    		out[i] = s0 + s3;
+
+    		const uint64_t t = s1 << 17;
+
+    		s2 ^= s0;
+    		s3 ^= s1;
+    		s1 ^= s2;
+    		s0 ^= s3;
+
+    		s2 ^= t;
+
+    		s3 = rotl(s3, 45);
+    	}
+    	s[0] = s0;
+    	s[1] = s1;
+    	s[2] = s2;
+    	s[3] = s3;
+    }
+
+
     /* This is the jump function for the generator. It is equivalent
        to 2^128 calls to next(); it can be used to generate 2^128
        non-overlapping subsequences for parallel computations. */
     inline void jump(void) {
-    	static const uint64_t JUMP[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+    	JumpAhead<Xoshiro256plus>::jump(*this, 1);
+    }
+
+    /* This is the long-jump function for the generator. It is equivalent to
+       2^192 calls to next(); it can be used to generate starting points,
+       from each of which jump() generates further non-overlapping
+       subsequences. */
+    inline void long_jump(void) {
+    	JumpAhead<Xoshiro256plus>::longJump(*this);
+    }
+
+    /* x^(2^192) modulo the characteristic polynomial. */
+    static inline StateType longJumpPolynomial() {
+    	return {{ 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 }};
+    }
+
+    /* x^(2^128) modulo the characteristic polynomial (see JumpAhead.hpp). */
+    static constexpr StateType jumpPolynomial() {
+    	return {{ 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c }};
+    }
+    static const unsigned int jumpIndexBits = 128;
+    /* The lowest three bits might fail linearity tests. */
+    static const unsigned int weakLowBits = 3;
 
+    /* Replaces the state by sum_b JUMP_b next^b(state). */
+    inline void applyJumpPolynomial(const StateType& JUMP) {
     	uint64_t s0 = 0;
     	uint64_t s1 = 0;
     	uint64_t s2 = 0;
     	uint64_t s3 = 0;
-    	for(std::size_t i = 0; i < sizeof JUMP / sizeof *JUMP; i++)
+    	for(std::size_t i = 0; i < JUMP.size(); i++)
     		for(std::size_t b = 0; b < 64; b++) {
-    			if (JUMP[i] & UINT64_C(1) << b) {
-    				s0 ^= s[0];
-    				s1 ^= s[1];
-    				s2 ^= s[2];
-    				s3 ^= s[3];
-    			}
+    			const uint64_t mask = UINT64_C(0) - ((JUMP[i] >> b) & 1);
+    			s0 ^= s[0] & mask;
+    			s1 ^= s[1] & mask;
+    			s2 ^= s[2] & mask;
+    			s3 ^= s[3] & mask;
     			next();	
     		}
     		
@@ -74,11 +74,32 @@ struct Xoshiro256plusSIMDPP: public GeneratorImplementation<Xoshiro256plusSIMDPP
        to 2^128 calls to next(); it can be used to generate 2^128
        non-overlapping subsequences for parallel computations. */
     inline void jump(void) {
-    	static const uint64_t JUMP[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+    	applyJumpPolynomial(jumpPolynomial());
+    }
+
+    /* x^(2^128) modulo the characteristic polynomial (see JumpAhead.hpp). */
+    static inline StateType jumpPolynomial() {
+    	return {{ 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c }};
+    }
+    static const unsigned int jumpIndexBits = 128;
+    /* The lowest three bits might fail linearity tests. */
+    static const unsigned int weakLowBits = 3;
+
+    /* Equivalent to 2^192 calls to next(). */
+    inline void long_jump(void) {
+    	applyJumpPolynomial(longJumpPolynomial());
+    }
+
+    /* x^(2^192) modulo the characteristic polynomial. */
+    static inline StateType longJumpPolynomial() {
+    	return {{ 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 }};
+    }
 
+    /* Replaces the state by sum_b JUMP_b next^b(state). */
+    inline void applyJumpPolynomial(const StateType& JUMP) {
     	using namespace simdpp;
     	SV si = make_int<SV>(0,0,0,0);
-    	for(std::size_t i = 0; i < sizeof JUMP / sizeof *JUMP; i++)
+    	for(std::size_t i = 0; i < JUMP.size(); i++)
     		for(std::size_t b = 0; b < 64; b++) {
     			if (JUMP[i] & UINT64_C(1) << b) {
     				si = (si ^ make_int<SV>(s[0],s[1],s[2],s[3])).eval();
@@ -0,0 +1,120 @@
+#ifndef Ziggurat_hpp_INCLUDED
+#define Ziggurat_hpp_INCLUDED
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+
+namespace PRNG {
+
+/*
+ * Ziggurat - standard normal variates (Marsaglia & Tsang, 2000)
+ *
+ * 256 layers of equal area under the density. One 64 bit output supplies
+ * the layer (top 8 bits), the sign (bit 55) and a 52 bit abscissa (bits 3
+ * to 54), leaving out the low bits that are weak for the + scramblers
+ * (weakLowBits); it is accepted by a single table lookup and compare in
+ * about 99% of the cases.
+ * The remaining draws either sample the tail beyond r or test the wedge
+ * against exp(), both consuming further outputs.
+ *
+ * The tables are computed on first use (std::exp/std::log are not constexpr
+ * before C++26).
+ */
+struct Ziggurat {
+    static const unsigned int layers = 256;
+
+    struct Tables {
+        uint64_t k[layers];   // acceptance thresholds of the 52 bit abscissa
+        double   w[layers];   // abscissa scale per layer
+        double   f[layers];   // density at the layer edges
+    };
+
+    static constexpr double r = 3.6541528853610088;      // start of the tail
+    static constexpr double v = 0.00492867323399;        // area of each layer
+    static constexpr double m = 4503599627370496.;       // 2^52
+
+    static const Tables& tables() {
+        static const Tables t = buildTables();
+        return t;
+    }
+
+    static Tables buildTables() {
+        Tables t;
+        double dn = r, tn = r;
+        const double q = v / std::exp(-0.5*dn*dn);
+        t.k[0] = (uint64_t)((dn/q)*m);
+        t.k[1] = 0;
+        t.w[0] = q/m;
+        t.w[layers-1] = dn/m;
+        t.f[0] = 1.;
+        t.f[layers-1] = std::exp(-0.5*dn*dn);
+        for(unsigned int i=layers-2; i>=1; --i) {
+            dn = std::sqrt(-2.*std::log(v/dn + std::exp(-0.5*dn*dn)));
+            t.k[i+1] = (uint64_t)((dn/tn)*m);
+            tn = dn;
+            t.f[i] = std::exp(-0.5*dn*dn);
+            t.w[i] = dn/m;
+        }
+        return t;
+    }
+
+    /* (double)x for x < 2^52 by mantissa injection; vectorizes without
+       a packed 64 bit integer conversion. */
+    static inline double toDouble52(uint64_t x) {
+        const uint64_t bits = x | UINT64_C(0x4330000000000000);
+        double d;
+        std::memcpy(&d, &bits, sizeof(double));
+        return d - m;
+    }
+
+    static inline uint64_t index(uint64_t x)    { return x >> 56; }
+    static inline uint64_t abscissa(uint64_t x) { return (x >> 3) & UINT64_C(0x000fffffffffffff); }
+    static inline bool     negative(uint64_t x) { return (x >> 55) & 1; }
+
+    /* a with the sign bit flipped if raw says so; a select on the sign
+       would be a branch mispredicted every other call. */
+    static inline double applySign(uint64_t raw, double a) {
+        uint64_t bits;
+        std::memcpy(&bits, &a, sizeof(double));
+        bits ^= (uint64_t)negative(raw) << 63;
+        std::memcpy(&a, &bits, sizeof(double));
+        return a;
+    }
+
+    /* The fast path: x is the variate if accepted. */
+    static inline bool fast(const Tables& t, uint64_t raw, double& x) {
+        const uint64_t idx  = index(raw);
+        const uint64_t rabs = abscissa(raw);
+        x = applySign(raw, toDouble52(rabs) * t.w[idx]);
+        return rabs < t.k[idx];
+    }
+
+    /*
+     * One standard normal variate. next() returns raw outputs, unit() maps
+     * them to uniform doubles in [0,1).
+     */
+    template<typename Next, typename Unit>
+    static inline double normal(const Tables& t, Next&& next, Unit unit) {
+        for(;;) {
+            const uint64_t raw = next();
+            double x;
+            if(fast(t, raw, x)) return x;
+
+            const uint64_t idx = index(raw);
+            if(idx == 0) {
+                for(;;) {
+                    const double xx = -std::log1p(-unit(next())) / r;
+                    const double yy = -std::log1p(-unit(next()));
+                    if(yy + yy > xx*xx) return applySign(raw, r + xx);
+                }
+            }
+            if((t.f[idx-1] - t.f[idx]) * unit(next()) + t.f[idx] < std::exp(-0.5*x*x)) return x;
+        }
+    }
+};
+
+}
+
+#endif // Ziggurat_hpp_INCLUDED
@@ -0,0 +1,31 @@
+/*
+ * libcpprand - the explicit instantiations declared by CPPRAND_INSTANTIATE
+ *
+ * Every header is included here, so linking this translation unit with
+ * the ones of the user also checks that the headers are inline-correct.
+ */
+#include "RandomGenerators.hpp"
+#include "AnyGenerator.hpp"
+#include "BufferedGenerator.hpp"
+#include "GeneratorPool.hpp"
+#include "ParallelFill.hpp"
+#include "StateArena.hpp"
+#include "StaticSplitting.hpp"
+
+#ifdef _USE_SIMDPP
+#define SIMDPP_ARCH_X86_SSE2
+#define SIMDPP_ARCH_X86_SSE3
+#define SIMDPP_ARCH_X86_SSSE3
+#define SIMDPP_ARCH_X86_SSE4_1
+
+#include "simdpp/simd.h"
+#include "RandomGeneratorsSIMD.hpp"
+#endif
+
+namespace PRNG {
+
+CPPRAND_INSTANTIATE()
+
+template struct RandomGenerator<AnyImplementation>;
+
+}
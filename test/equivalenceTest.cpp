@@ -0,0 +1,616 @@
+#include "RandomGenerators.hpp"
+#include "BufferedGenerator.hpp"
+#include "ParallelFill.hpp"
+#include "AnyGenerator.hpp"
+
+#ifdef _USE_SIMDPP
+#define SIMDPP_ARCH_X86_SSE2
+#define SIMDPP_ARCH_X86_SSE3
+#define SIMDPP_ARCH_X86_SSSE3
+#define SIMDPP_ARCH_X86_SSE4_1
+
+#include "simdpp/simd.h"
+#include "RandomGeneratorsSIMD.hpp"
+#endif
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cstring>
+#include <assert.h>
+
+using namespace PRNG;
+
+/*
+ * Equivalence - every accelerated path bit for bit against the scalar code
+ *
+ *  - the generators against the original C implementations
+ *    (prng.di.unimi.it, transcribed below) and published output vectors,
+ *    including their jump() and long_jump()
+ *  - next_n(), fill<T>, fillFloatPairs, fillDense, fillRange and
+ *    fillNormal against next(), rand<T>, randFloatPair, randDoubleDense,
+ *    randRange and randNormal at every kernel level of CpuDispatch.hpp
+ *  - multi-lane, buffered and SIMDPP generators against the scalar one
+ *  - jumpAhead(), discard() and parallelFill against their definition
+ *
+ * Philox4x32 is checked against the Random123 known answers in jumpTest.
+ */
+
+namespace reference {
+
+static inline uint64_t rotl(const uint64_t x, int k) {
+	return (x << k) | (x >> (64 - k));
+}
+
+struct splitmix64 {
+	uint64_t x;
+
+	uint64_t next() {
+		uint64_t z = (x += 0x9e3779b97f4a7c15);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		return z ^ (z >> 31);
+	}
+};
+
+struct xorshift1024star {
+	uint64_t s[16];
+	int p;
+
+	uint64_t next(void) {
+		const uint64_t s0 = s[p];
+		uint64_t s1 = s[p = (p + 1) & 15];
+		s1 ^= s1 << 31; // a
+		s[p] = s1 ^ s0 ^ (s1 >> 11) ^ (s0 >> 30); // b,c
+		return s[p] * UINT64_C(1181783497276652981);
+	}
+
+	void jump(void) {
+		static const uint64_t JUMP[] = { 0x84242f96eca9c41d,
+			0xa3c65b8776f96855, 0x5b34a39f070b5837, 0x4489affce4f31a1e,
+			0x2ffeeb0a48316f40, 0xdc2d9891fe68c022, 0x3659132bb12fea70,
+			0xaac17d8efa43cab8, 0xc4cb815590989b13, 0x5ee975283d71c93b,
+			0x691548c86c1bd540, 0x7910c41d10a1e6a5, 0x0b5fc64563b3e2a8,
+			0x047f7684e9fc949d, 0xb99181f2d8f685ca, 0x284600e3f30e38c3
+		};
+
+		uint64_t t[16] = { 0 };
+		for(int i = 0; i < (int)(sizeof JUMP / sizeof *JUMP); i++)
+			for(int b = 0; b < 64; b++) {
+				if (JUMP[i] & UINT64_C(1) << b)
+					for(int j = 0; j < 16; j++)
+						t[j] ^= s[(j + p) & 15];
+				next();
+			}
+
+		for(int j = 0; j < 16; j++)
+			s[(j + p) & 15] = t[j];
+	}
+};
+
+struct xorshift128plus {
+	uint64_t s[2];
+
+	uint64_t next(void) {
+		uint64_t s1 = s[0];
+		const uint64_t s0 = s[1];
+		const uint64_t result = s0 + s1;
+		s[0] = s0;
+		s1 ^= s1 << 23; // a
+		s[1] = s1 ^ s0 ^ (s1 >> 18) ^ (s0 >> 5); // b, c
+		return result;
+	}
+
+	void jump(void) {
+		static const uint64_t JUMP[] = { 0x8a5cd789635d2dff, 0x121fd2155c472f96 };
+
+		uint64_t s0 = 0;
+		uint64_t s1 = 0;
+		for(int i = 0; i < (int)(sizeof JUMP / sizeof *JUMP); i++)
+			for(int b = 0; b < 64; b++) {
+				if (JUMP[i] & UINT64_C(1) << b) {
+					s0 ^= s[0];
+					s1 ^= s[1];
+				}
+				next();
+			}
+
+		s[0] = s0;
+		s[1] = s1;
+	}
+};
+
+struct xoroshiro128plus {
+	uint64_t s[2];
+
+	uint64_t next(void) {
+		const uint64_t s0 = s[0];
+		uint64_t s1 = s[1];
+		const uint64_t result = s0 + s1;
+
+		s1 ^= s0;
+		s[0] = rotl(s0, 55) ^ s1 ^ (s1 << 14); // a, b
+		s[1] = rotl(s1, 36); // c
+
+		return result;
+	}
+
+	void jump(void) {
+		static const uint64_t JUMP[] = { 0xbeac0467eba5facb, 0xd86b048b86aa9922 };
+
+		uint64_t s0 = 0;
+		uint64_t s1 = 0;
+		for(int i = 0; i < (int)(sizeof JUMP / sizeof *JUMP); i++)
+			for(int b = 0; b < 64; b++) {
+				if (JUMP[i] & UINT64_C(1) << b) {
+					s0 ^= s[0];
+					s1 ^= s[1];
+				}
+				next();
+			}
+
+		s[0] = s0;
+		s[1] = s1;
+	}
+};
+
+/* xoshiro256+ and xoshiro256** share the state transition and jumps. */
+template<bool starstar>
+struct xoshiro256 {
+	uint64_t s[4];
+
+	uint64_t next(void) {
+		const uint64_t result = starstar ? rotl(s[1] * 5, 7) * 9 : s[0] + s[3];
+
+		const uint64_t t = s[1] << 17;
+
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+
+		s[2] ^= t;
+
+		s[3] = rotl(s[3], 45);
+
+		return result;
+	}
+
+	void apply(const uint64_t* JUMP) {
+		uint64_t s0 = 0;
+		uint64_t s1 = 0;
+		uint64_t s2 = 0;
+		uint64_t s3 = 0;
+		for(int i = 0; i < 4; i++)
+			for(int b = 0; b < 64; b++) {
+				if (JUMP[i] & UINT64_C(1) << b) {
+					s0 ^= s[0];
+					s1 ^= s[1];
+					s2 ^= s[2];
+					s3 ^= s[3];
+				}
+				next();
+			}
+
+		s[0] = s0;
+		s[1] = s1;
+		s[2] = s2;
+		s[3] = s3;
+	}
+
+	void jump(void) {
+		static const uint64_t JUMP[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+		apply(JUMP);
+	}
+
+	void long_jump(void) {
+		static const uint64_t LONG_JUMP[] = { 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 };
+		apply(LONG_JUMP);
+	}
+};
+using xoshiro256plus     = xoshiro256<false>;
+using xoshiro256starstar = xoshiro256<true>;
+
+}
+
+/* The library generator that continues exactly where ref is. */
+template<typename GenImpl, typename Ref>
+GenImpl fromReference(const Ref& ref) {
+    typename GenImpl::StateType state;
+    std::memcpy(state.data(), ref.s, sizeof(ref.s));
+    return GenImpl(state);
+}
+template<>
+Xorshift1024star fromReference<Xorshift1024star>(const reference::xorshift1024star& ref) {
+    std::array<uint64_t,16> state;
+    for(unsigned int j = 0; j < 16; j++) state[(j + 15) & 15] = ref.s[(j + ref.p) & 15];
+    return Xorshift1024star(state);
+}
+
+// The first four outputs and two after jump(), from the reference code
+template<typename GenImpl, typename Ref>
+void checkVector(Ref ref, const std::array<uint64_t,6>& expected) {
+    GenImpl gen = fromReference<GenImpl>(ref);
+    for(unsigned int i=0; i<6; ++i) {
+        if(i == 4) {
+            ref.jump();
+            gen.jump();
+        }
+        assert(ref.next() == expected[i]);
+        assert(gen.next() == expected[i]);
+    }
+}
+
+// next(), jump(), jumpAhead() and discard() against the reference
+template<typename GenImpl, typename Ref>
+void checkReference(Ref ref, unsigned int jumps) {
+    GenImpl gen = fromReference<GenImpl>(ref);
+    for(unsigned int i=0; i<1000; ++i) assert(gen.next() == ref.next());
+
+    GenImpl ahead = gen;
+    Ref refAhead = ref;
+    for(unsigned int j=0; j<jumps; ++j) {
+        gen.jump();
+        ref.jump();
+        assert(gen.getState() == fromReference<GenImpl>(ref).getState());
+        for(unsigned int i=0; i<100; ++i) assert(gen.next() == ref.next());
+        refAhead.jump();
+    }
+    ahead.jumpAhead(jumps);
+    for(unsigned int i=0; i<100; ++i) assert(ahead.next() == refAhead.next());
+
+    for(unsigned int n : {1, 17, 1000}) {
+        GenImpl skip = fromReference<GenImpl>(ref);
+        skip.discard(n);
+        for(unsigned int i=0; i<n; ++i) ref.next();
+        assert(skip.next() == ref.next());
+    }
+}
+
+template<typename GenImpl, bool starstar>
+void checkLongJump(reference::xoshiro256<starstar> ref) {
+    GenImpl gen = fromReference<GenImpl>(ref);
+    gen.long_jump();
+    ref.long_jump();
+    for(unsigned int i=0; i<100; ++i) assert(gen.next() == ref.next());
+}
+
+// fill<T> against rand<T>
+template<typename T, typename Gen>
+void checkFill(const Gen& start) {
+    for(std::size_t n : {1, 5, 1000, 4099}) {
+        Gen bulk = start, scalar = start;
+        std::vector<T> u(n);
+        bulk.fill(u.data(), n);
+        for(std::size_t i=0; i<n; ++i) assert(u[i] == scalar.template rand<T>());
+        assert(bulk.next() == scalar.next());
+    }
+}
+
+// fillRange against randRange
+template<typename T, typename Gen>
+void checkFillRange(const Gen& start, T lo, T hi) {
+    for(std::size_t n : {1, 5, 1000, 4099}) {
+        Gen bulk = start, scalar = start;
+        std::vector<T> u(n);
+        bulk.fillRange(u.data(), n, lo, hi);
+        for(std::size_t i=0; i<n; ++i) assert(u[i] == scalar.randRange(lo, hi));
+        assert(bulk.next() == scalar.next());
+    }
+}
+
+// fillNormal against randNormal
+template<typename T, typename Gen>
+void checkFillNormal(const Gen& start) {
+    for(std::size_t n : {1, 5, 1000, 4099}) {
+        Gen bulk = start, scalar = start;
+        std::vector<T> u(n);
+        bulk.fillNormal(u.data(), n, T(1), T(2));
+        for(std::size_t i=0; i<n; ++i) assert(u[i] == scalar.randNormal(T(1), T(2)));
+        assert(bulk.next() == scalar.next());
+    }
+}
+
+// The ziggurat reads layer and sign from the top bits, the abscissa from
+// bits 3 to 54; the weak low bits have no influence
+void checkZigguratBits() {
+    const Ziggurat::Tables& t = Ziggurat::tables();
+    for(uint64_t idx : {0, 1, 17, 128, 255}) {
+        for(uint64_t a : {UINT64_C(0), UINT64_C(12345), UINT64_C(0x000fffffffffffff)}) {
+            const uint64_t raw = (idx << 56) | (a << 3);
+            assert(Ziggurat::index(raw) == idx);
+            assert(Ziggurat::abscissa(raw) == a);
+            assert(!Ziggurat::negative(raw));
+            assert(Ziggurat::negative(raw | (UINT64_C(1) << 55)));
+            double x, neg;
+            const bool accepted = Ziggurat::fast(t, raw, x);
+            assert(Ziggurat::fast(t, raw | (UINT64_C(1) << 55), neg) == accepted);
+            assert(neg == -x);
+            for(uint64_t low=1; low<8; ++low) {
+                double y;
+                assert(Ziggurat::fast(t, raw | low, y) == accepted);
+                assert(y == x);
+            }
+        }
+    }
+}
+
+// fillFloatPairs against randFloatPair
+template<typename Gen>
+void checkFloatPairs(const Gen& start) {
+    for(std::size_t n : {1, 2, 5, 512, 513, 4099}) {
+        Gen bulk = start, scalar = start;
+        std::vector<float> u(n);
+        bulk.fillFloatPairs(u.data(), n);
+        for(std::size_t i=0; i<n; i+=2) {
+            const std::array<float,2> pair = scalar.randFloatPair();
+            assert(u[i] == pair[0]);
+            if(i+1 < n) assert(u[i+1] == pair[1]);
+        }
+        assert(bulk.next() == scalar.next());
+    }
+}
+
+// fillDense against randDoubleDense, also with the short output (12 or more
+// leading zeros) at the ends of a block
+template<typename Gen>
+void checkDense(const Gen& start) {
+    Gen scan = start;
+    std::size_t shortAt = 0;
+    while((scan.next() >> 52) != 0) ++shortAt;
+    for(std::size_t skip : {std::size_t(0), shortAt, shortAt > 255 ? shortAt-255 : 0}) {
+        for(std::size_t n : {1, 5, 256, 1000}) {
+            Gen bulk = start;
+            for(std::size_t i=0; i<skip; ++i) bulk.next();
+            Gen scalar = bulk;
+            std::vector<double> u(n);
+            bulk.fillDense(u.data(), n);
+            for(std::size_t i=0; i<n; ++i) assert(u[i] == scalar.randDoubleDense());
+            assert(bulk.next() == scalar.next());
+        }
+    }
+}
+
+// The block paths against the scalar ones, at the current kernel level
+template<typename GenImpl>
+void checkPaths(const RandomGenerator<GenImpl>& start) {
+    for(std::size_t n : {0, 1, 3, 7, 64, 1000, 4097}) {
+        RandomGenerator<GenImpl> bulk = start, scalar = start;
+        std::vector<uint64_t> raw(n);
+        bulk.next_n(raw.data(), n);
+        for(std::size_t i=0; i<n; ++i) assert(raw[i] == scalar.next());
+        assert(bulk.next() == scalar.next());
+    }
+    checkFill<uint64_t>(start);
+    checkFill<uint32_t>(start);
+    checkFill<int16_t>(start);
+    checkFill<uint8_t>(start);
+    checkFill<double>(start);
+    checkFill<float>(start);
+    checkFloatPairs(start);
+    checkDense(start);
+    checkFillRange<int>(start, 0, 12);
+    checkFillRange<int>(start, -7, 5);
+    checkFillRange<uint32_t>(start, 0, 3u << 30);
+    checkFillRange<uint64_t>(start, 5, 3ull << 62);
+    checkFillRange<double>(start, -1.0, 2.0);
+    checkFillNormal<double>(start);
+    checkFillNormal<float>(start);
+}
+
+// Lane l of a multi-lane generator is the scalar one after l jumps
+template<typename Multi, typename Scalar>
+void checkLanes(Scalar scalar) {
+    Multi multi(scalar.getState());
+    std::vector<Scalar> lanes;
+    for(std::size_t l=0; l<Multi::lanes; ++l) {
+        lanes.push_back(scalar);
+        scalar.jump();
+    }
+    std::vector<uint64_t> block(Multi::lanes * 333 + 5);
+    multi.next_n(block.data(), block.size());
+    for(std::size_t i=0; i<block.size(); ++i) assert(block[i] == lanes[i % Multi::lanes].next());
+}
+
+#ifdef _USE_SIMDPP
+template<typename SIMD, typename Scalar>
+void checkSIMDPP(Scalar scalar) {
+    SIMD simd(scalar.getState());
+    for(unsigned int i=0; i<1000; ++i) assert(simd.next() == scalar.next());
+    simd.jump();
+    scalar.jump();
+    assert(simd.getState() == scalar.getState());
+    simd.long_jump();
+    scalar.long_jump();
+    for(unsigned int i=0; i<1000; ++i) assert(simd.next() == scalar.next());
+}
+#endif
+
+// parallelFill is fill(); chunk c of the others is the c-th jump()
+template<typename GenImpl>
+void checkParallel(int seed) {
+    SequenceSplitting<GenImpl,true,Splitmix64> source(seed);
+    const std::size_t n = 10000, chunk = 1024;
+    std::vector<double> ref(n);
+    source.getGenerator().fill(ref.data(), n);
+    std::vector<int> refRange(n);
+    std::vector<double> refNormal(n);
+    for(std::size_t c=0; c*chunk<n; ++c) {
+        auto gen = source.getGenerator();
+        gen.jumpAhead(c);
+        const std::size_t len = std::min(chunk, n - c*chunk);
+        auto normal = gen;
+        gen.fillRange(refRange.data() + c*chunk, len, -5, 17);
+        normal.fillNormal(refNormal.data() + c*chunk, len, 0.0, 1.0);
+    }
+    for(unsigned int threads : {1u, 3u, 8u}) {
+        std::vector<double> u(n), normals(n);
+        std::vector<int> ranges(n);
+        parallelFill(source, u.data(), n, threads, chunk);
+        parallelFillRange(source, ranges.data(), n, -5, 17, threads, chunk);
+        parallelFillNormal(source, normals.data(), n, 0.0, 1.0, threads, chunk);
+        assert(u == ref);
+        assert(ranges == refRange);
+        assert(normals == refNormal);
+    }
+}
+
+// AnyGenerator and AnySource of name are the concrete ones, also across
+// jumps taken in the middle of its buffer
+template<typename GenImpl>
+void checkAnyJumps(AnyGenerator& any, RandomGenerator<GenImpl>& gen, std::true_type) {
+    any.jump();
+    gen.jump();
+    for(unsigned int i=0; i<100; ++i) assert(any.next() == gen.next());
+    any.jumpAhead(3);
+    gen.jumpAhead(3);
+    for(unsigned int i=0; i<100; ++i) assert(any.next() == gen.next());
+    any.discard(1000);
+    gen.discard(1000);
+    for(unsigned int i=0; i<100; ++i) assert(any.next() == gen.next());
+}
+template<typename GenImpl>
+void checkAnyJumps(AnyGenerator& any, RandomGenerator<GenImpl>&, std::false_type) {
+    bool thrown = false;
+    try { any.jump(); } catch(const std::logic_error&) { thrown = true; }
+    assert(thrown);
+}
+
+template<typename GenImpl>
+void checkAny(const std::string& name, int seed) {
+    AnyGenerator any = anyGenerator(name, seed);
+    RandomGenerator<GenImpl> gen(seed);
+    assert(any.type() == typeid(GenImpl));
+    assert(((any.target<Splitmix64>() == nullptr) != std::is_same<GenImpl, Splitmix64>::value));
+    for(unsigned int i=0; i<1000; ++i) assert(any.next() == gen.next());
+    for(std::size_t n : {1, 7, 64, 1000}) {
+        std::vector<uint64_t> a(n), b(n);
+        any.fill(a.data(), n);
+        gen.fill(b.data(), n);
+        assert(a == b);
+        std::vector<double> u(n), v(n);
+        any.fill(u.data(), n);
+        gen.fill(v.data(), n);
+        assert(u == v);
+    }
+    for(unsigned int i=0; i<10; ++i) assert(any.rand<double>() == gen.template rand<double>());
+    GenImpl at = *any.target<GenImpl>();
+    assert(at.next() == static_cast<GenImpl&>(gen).next());
+    any.next();
+    checkAnyJumps(any, gen, std::integral_constant<bool, GenImpl::jumpAble>());
+
+    const std::string policy = GenImpl::jumpAble ? "splitting" : "spacing";
+    AnySource anySrc = anySource(name, policy, seed);
+    typename std::conditional<GenImpl::jumpAble, SequenceSplitting<GenImpl,true,Splitmix64>,
+        RandomSpacing<GenImpl,true,Splitmix64> >::type source(seed);
+    AnyGenerator first = anySrc.getGenerator();
+    auto ref = source.getGenerator();
+    for(unsigned int i=0; i<100; ++i) assert(first.next() == ref.next());
+    anySrc.newSource();
+    source.newSource();
+    AnyGenerator child = anySrc.newSource().getGenerator();
+    auto refChild = source.newSource().getGenerator();
+    for(unsigned int i=0; i<100; ++i) assert(child.next() == refChild.next());
+}
+
+template<typename GenImpl>
+void checkAllPaths(int seed) {
+    checkPaths(RandomGenerator<GenImpl>(seed));
+}
+
+int main() {
+    const int seed = 4711;
+
+    // published vectors: splitmix64 of 1234567 and xoshiro256** of {1,2,3,4}
+    const uint64_t splitmix[5] = { 6457827717110365317ull, 3203168211198807973ull, 9817491932198370423ull,
+                                   4593380528125082431ull, 16408922859458223821ull };
+    reference::splitmix64 refMix{1234567};
+    Splitmix64 mix(1234567);
+    for(unsigned int i=0; i<5; ++i) {
+        assert(refMix.next() == splitmix[i]);
+        assert(mix.next() == splitmix[i]);
+    }
+    checkVector<Xoshiro256starstar>(reference::xoshiro256starstar{{1, 2, 3, 4}},
+        {{ 11520, 0, 1509978240, 1215971899390074240ull, 0x986a928c99a10251, 0x02a79ef4cc0c7a67 }});
+    checkVector<Xoshiro256plus>(reference::xoshiro256plus{{1, 2, 3, 4}},
+        {{ 0x0000000000000005, 0x0000c00000000007, 0x0000c00018000007, 0x8001600018040302, 0xcda1f5c8d4c14cee, 0x1fa321fd3b072770 }});
+    checkVector<Xoroshiro128plus>(reference::xoroshiro128plus{{1, 2}},
+        {{ 0x0000000000000003, 0x008000300000c003, 0x0118406038000363, 0xa080fe5030c4c366, 0xbd287e9ce1598f07, 0xaa5fae8ec95ac221 }});
+    checkVector<Xorshift128plus>(reference::xorshift128plus{{1, 2}},
+        {{ 0x0000000000000003, 0x0000000000800025, 0x0000000002040083, 0x00004000020c2460, 0x79f37906ccf84c9f, 0x71c5d25f9c180b51 }});
+    checkVector<Xorshift1024star>(reference::xorshift1024star{{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}, 0},
+        {{ 0xc0562e31b467f91f, 0x092b6fabadaff6d4, 0x06a37d6c71bffb6a, 0xd534ffc84bb7e231, 0x0c69581766143eef, 0x6dd2134e91ed9ae3 }});
+
+    // reference code seeded like the library: splitmix64 outputs
+    reference::splitmix64 seeder{(uint64_t)seed};
+    auto seeded = [&](auto ref) {
+        for(auto& w : ref.s) w = seeder.next();
+        return ref;
+    };
+    for(unsigned int i=0; i<1000; ++i) {
+        reference::splitmix64 ref{(uint64_t)seed + i};
+        assert(Splitmix64((uint64_t)seed + i).next() == ref.next());
+    }
+    checkReference<Xorshift1024star>(seeded(reference::xorshift1024star{{}, 5}), 3);
+    checkReference<Xorshift128plus>(seeded(reference::xorshift128plus{}), 5);
+    checkReference<Xoroshiro128plus>(seeded(reference::xoroshiro128plus{}), 5);
+    checkReference<Xoshiro256plus>(seeded(reference::xoshiro256plus{}), 5);
+    checkReference<Xoshiro256starstar>(seeded(reference::xoshiro256starstar{}), 5);
+    checkLongJump<Xoshiro256plus>(seeded(reference::xoshiro256plus{}));
+    checkLongJump<Xoshiro256starstar>(seeded(reference::xoshiro256starstar{}));
+
+#ifdef _USE_SIMDPP
+    checkSIMDPP<Xoshiro256plusSIMDPP>(xoshiro256plus(seed));
+    checkSIMDPP<Xoshiro256starstarSIMDPP>(xoshiro256starstar(seed));
+#endif
+
+    checkZigguratBits();
+
+    // every kernel level the CPU has, against the level independent scalar code
+    const SimdLevel detected = simdLevel();
+    for(SimdLevel level : {SimdLevel::Baseline, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if((int)level > (int)detectSimdLevel()) continue;
+        setSimdLevel(level);
+        checkAllPaths<Splitmix64>(seed);
+        checkAllPaths<Xorshift1024star>(seed);
+        checkAllPaths<Xorshift128plus>(seed);
+        checkAllPaths<Xoroshiro128plus>(seed);
+        checkAllPaths<Xoshiro256plus>(seed);
+        checkAllPaths<Xoshiro256starstar>(seed);
+        checkAllPaths<Xoshiro256plusX4>(seed);
+        checkAllPaths<Xoshiro256plusX8>(seed);
+        checkAllPaths<Xoshiro256starstarX4>(seed);
+        checkAllPaths<Xoshiro256starstarX8>(seed);
+        checkAllPaths<Philox4x32>(seed);
+        checkAllPaths<BufferedImplementation<Xoshiro256plus> >(seed);
+        checkAllPaths<BufferedImplementation<Xoshiro256plusX8,64> >(seed);
+        checkPaths(anyGenerator("xoshiro256plus", seed));
+        checkPaths(anyGenerator("philox4x32", seed));
+
+        checkLanes<Xoshiro256plusX4>(xoshiro256plus(seed));
+        checkLanes<Xoshiro256plusX8>(xoshiro256plus(seed));
+        checkLanes<Xoshiro256starstarX4>(xoshiro256starstar(seed));
+        checkLanes<Xoshiro256starstarX8>(xoshiro256starstar(seed));
+
+        checkParallel<Xoshiro256plus>(seed);
+        checkParallel<Xoshiro256starstarX4>(seed);
+        checkParallel<Philox4x32>(seed);
+    }
+    setSimdLevel(detected);
+
+    for(const std::string& name : generatorNames()) {
+        const bool known = visitGenerator(name, [&](auto tag) {
+            checkAny<typename decltype(tag)::type>(name, seed);
+        });
+        assert(known);
+    }
+    bool thrown = false;
+    try { anyGenerator("mt19937", seed); } catch(const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+    thrown = false;
+    try { anySource("splitmix64", "splitting", seed); } catch(const std::invalid_argument&) { thrown = true; }
+    assert(thrown || Splitmix64::jumpAble);
+
+    std::cout << "equivalenceTest passed" << std::endl;
+    return(0);
+}
@@ -0,0 +1,230 @@
+#include "RandomGenerators.hpp"
+
+#include <iostream>
+#include <string>
+#include <set>
+#include <vector>
+#include <assert.h>
+
+using namespace PRNG;
+
+// x^(2^jumpLog2) mod P has to reproduce the reference JUMP constant
+template<typename GenImpl>
+void testJumpPolynomial(unsigned int jumpLog2) {
+    using JA = JumpAhead<GenImpl>;
+    typename JA::Poly x{};
+    x[0] = 2;
+    for(unsigned int i=0; i<jumpLog2; ++i) x = JA::mulmod(x,x);
+    assert(x == GenImpl::jumpPolynomial());
+}
+
+// jumpAhead(k) is k times jump()
+template<typename GenImpl>
+void testJumpAhead(GenImpl gen) {
+    for(unsigned int k : {0, 1, 2, 3, 5, 13}) {
+        GenImpl ref = gen;
+        for(unsigned int i=0; i<k; ++i) ref.jump();
+        GenImpl fast = gen;
+        fast.jumpAhead(k);
+        assert(fast.next() == ref.next());
+        assert(fast.getState() == ref.getState());
+    }
+    JumpIndex big = (JumpIndex(1) << 64) + 3;
+    GenImpl a = gen, b = gen;
+    a.jumpAhead(big);
+    b.jumpAhead(JumpIndex(1) << 64);
+    b.jumpAhead(3);
+    assert(a.getState() == b.getState());
+}
+
+// the table driven jump(), long_jump() and discard() against the reference
+template<typename GenImpl>
+void testJumpKinds(GenImpl gen, unsigned int longJumpLog2) {
+    using JA = JumpAhead<GenImpl>;
+    GenImpl ref = gen, fast = gen;
+    ref.applyJumpPolynomial(GenImpl::jumpPolynomial());
+    fast.jump();
+    assert(fast.getState() == ref.getState());
+
+    typename JA::Poly x{};
+    x[0] = 2;
+    for(unsigned int i=0; i<longJumpLog2; ++i) x = JA::mulmod(x,x);
+    assert(x == GenImpl::longJumpPolynomial());
+    ref = gen;
+    ref.applyJumpPolynomial(x);
+    fast = gen;
+    fast.long_jump();
+    assert(fast.getState() == ref.getState());
+
+    for(unsigned int n : {0, 1, 7, 100, 3000}) {
+        ref = gen;
+        for(unsigned int i=0; i<n; ++i) ref.next();
+        fast = gen;
+        fast.discard(n);
+        assert(fast.next() == ref.next());
+    }
+}
+
+// Philox4x32-10 known answers (Random123 kat_vectors), random access and the
+// block kernel against next()
+void testPhilox() {
+    const uint32_t kat[3][6] = {
+        { 0x00000000, 0x00000000, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+        { 0xffffffff, 0xffffffff, 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+        { 0xa4093822, 0x299f31d0, 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } };
+    const uint32_t ctr[3][4] = {
+        { 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+        { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+        { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } };
+    for(unsigned int t=0; t<3; ++t) {
+        JumpIndex c = 0;
+        for(int w=3; w>=0; --w) c = (c << 32) | ctr[t][w];
+        const auto x = Philox4x32::block(kat[t][0] | ((uint64_t)kat[t][1] << 32), c);
+        for(unsigned int w=0; w<4; ++w) assert(x[w] == kat[t][2+w]);
+    }
+
+    Philox4x32 gen = philox4x32(4711);
+    for(unsigned int i=0; i<100; ++i) assert(gen.at(i) == philox4x32(4711).at(i));
+    std::vector<uint64_t> seq(1000);
+    for(auto& v : seq) v = gen.next();
+    for(unsigned int i : {0, 1, 2, 37, 997, 998}) {
+        assert(philox4x32(4711).at(i) == seq[i]);
+        Philox4x32 fast = philox4x32(4711);
+        fast.discard(i);
+        assert(fast.next() == seq[i]);
+        // restarting from a state in the middle of a block
+        Philox4x32 restored(fast.getState());
+        assert(restored.next() == seq[i+1]);
+    }
+    for(unsigned int start : {0, 1, 5}) {
+        for(std::size_t n : {0, 1, 2, 31, 32, 33, 100, 500}) {
+            Philox4x32 block = philox4x32(4711);
+            block.discard(start);
+            std::vector<uint64_t> out(n);
+            block.next_n(out.data(), n);
+            for(std::size_t i=0; i<n; ++i) assert(out[i] == seq[start+i]);
+            assert(block.next() == seq[start+n]);
+        }
+    }
+
+    // the 128 bit block counter carries into the upper words
+    for(JumpIndex start : { (JumpIndex(1) << 33) - 5, (JumpIndex(1) << 65) - 12 }) {
+        Philox4x32 carry(7, start);
+        std::vector<uint64_t> out(40);
+        carry.next_n(out.data(), out.size());
+        for(std::size_t i=0; i<out.size(); ++i) assert(out[i] == Philox4x32::at(7, start + i));
+    }
+
+    Philox4x32 jumped = gen;
+    jumped.long_jump();
+    assert(jumped.next() == gen.at(gen.counter + (JumpIndex(1) << 96)));
+}
+
+// newSource() as implemented before direct addressing: index repeated jumps
+template<typename GenImpl>
+struct LegacySplitting {
+    typename GenImpl::StateType state;
+    unsigned int index;
+    LegacySplitting newSource() {
+        GenImpl gen = RandomGenImplInitiator<GenImpl>::get(state);
+        for(unsigned int i=0;i<index;++i) gen.jump();
+        state = gen.getState();
+        index*=2;
+        gen.jump();
+        return LegacySplitting{gen.getState(), index+1};
+    }
+};
+
+template<typename GenImpl>
+void testSplitting(int seed) {
+    SequenceSplitting<GenImpl,true,Splitmix64> source(seed);
+    LegacySplitting<GenImpl> legacy{source.defaultGenInitState, 1};
+    auto root = source.defaultGenInitState;
+
+    // the legacy state is the split state, compare before splitting further
+    auto child1 = source.newSource();
+    auto legacy1 = legacy.newSource();
+    assert(child1.defaultGenInitState == legacy1.state);
+    auto child2 = source.newSource();
+    auto legacy2 = legacy.newSource();
+    assert(child2.defaultGenInitState == legacy2.state);
+    auto child21 = child2.newSource();
+    auto legacy21 = legacy2.newSource();
+    assert(child21.defaultGenInitState == legacy21.state);
+    auto child22 = child2.newSource();
+    auto legacy22 = legacy2.newSource();
+    assert(child22.defaultGenInitState == legacy22.state);
+
+    // direct addressing from the root state
+    JumpIndex node22 = SplitTree<GenImpl>::child(SplitTree<GenImpl>::child(1,2),2);
+    assert(child22.index == node22);
+    SequenceSplitting<GenImpl,true,Splitmix64> direct(root, node22);
+    assert(direct.getGenerator().next() == child22.getGenerator().next());
+}
+
+template<typename GenImpl>
+void testDeepSplitting(int seed, unsigned int depth) {
+    SequenceSplitting<GenImpl,true,Splitmix64> source(seed);
+    std::set<uint64_t> firsts;
+    firsts.insert(source.getGenerator().next());
+    for(unsigned int d=0; d<depth; ++d) {
+        source = source.newSource();
+        firsts.insert(source.getGenerator().next());
+    }
+    assert(firsts.size() == depth+1);
+}
+
+int main() {
+    int seed = 4711;
+
+    testJumpPolynomial<Xoroshiro128plus>(64);
+    testJumpPolynomial<Xorshift128plus>(64);
+    testJumpPolynomial<Xoshiro256plus>(128);
+    testJumpPolynomial<Xoshiro256starstar>(128);
+    testJumpPolynomial<Xorshift1024star>(512);
+
+    testJumpAhead(xoroshiro128plus(seed));
+    testJumpAhead(xorshift128plus(seed));
+    testJumpAhead(xoshiro256plus(seed));
+    testJumpAhead(xoshiro256starstar(seed));
+    testJumpAhead(xorshift1024star(seed));
+    testJumpAhead(Xoshiro256plusX4(xoshiro256plus(seed).getState()));
+    testJumpAhead(philox4x32(seed));
+
+    testJumpKinds(xoroshiro128plus(seed), 96);
+    testJumpKinds(xorshift128plus(seed), 96);
+    testJumpKinds(xoshiro256plus(seed), 192);
+    testJumpKinds(xoshiro256starstar(seed), 192);
+    testJumpKinds(xorshift1024star(seed), 768);
+
+    Xoshiro256plusX4 lanes(xoshiro256plus(seed).getState());
+    for(unsigned int n : {0, 3, 4, 9, 1001}) {
+        Xoshiro256plusX4 ref = lanes, fast = lanes;
+        ref.next();
+        fast.next();
+        for(unsigned int i=0; i<n; ++i) ref.next();
+        fast.discard(n);
+        assert(fast.next() == ref.next());
+    }
+    Splitmix64 mix(seed), mixRef(seed);
+    mix.discard(1000);
+    for(unsigned int i=0; i<1000; ++i) mixRef.next();
+    assert(mix.next() == mixRef.next());
+
+    testSplitting<Xoshiro256plus>(seed);
+    testSplitting<Xoroshiro128plus>(seed);
+    testSplitting<Xorshift1024star>(seed);
+    testSplitting<Philox4x32>(seed);
+
+    // deeper than the node index range: sources are rebased
+    testDeepSplitting<Xoshiro256plus>(seed, 1000);
+    testDeepSplitting<Xoroshiro128plus>(seed, 200);
+    testDeepSplitting<Philox4x32>(seed, 200);
+
+    testPhilox();
+    RandomSpacing<Philox4x32,true,Splitmix64> spacing(seed);
+    assert(spacing.newSource().getGenerator().next() != spacing.getGenerator().next());
+
+    std::cout << "jumpTest passed" << std::endl;
+    return(0);
+}
@@ -0,0 +1,157 @@
+#include "GeneratorPool.hpp"
+#include "ParallelFill.hpp"
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <thread>
+#include <stdexcept>
+#include <assert.h>
+
+using namespace PRNG;
+
+template<typename GenImpl>
+void testPool(int seed, std::size_t threads) {
+    using Source = SequenceSplitting<GenImpl,true,Splitmix64>;
+    Source source(seed);
+    GeneratorPool<GenImpl> pool(source, threads);
+    assert(reinterpret_cast<uintptr_t>(&pool.get(0)) % 64 == 0);
+
+    // thread t bound to index t sees the (t+1)-th split of the source
+    std::vector<std::vector<uint64_t> > drawn(threads);
+    std::vector<std::thread> workers;
+    for(std::size_t t=0; t<threads; ++t) {
+        workers.emplace_back([&pool, &drawn, t]() {
+            pool.bind(t);
+            auto& gen = pool.local();
+            assert(&gen == &pool.local());
+            for(unsigned int i=0; i<1000; ++i) drawn[t].push_back(pool.local().next());
+        });
+    }
+    for(auto& w : workers) w.join();
+
+    Source manual(seed);
+    for(std::size_t t=0; t<threads; ++t) {
+        auto gen = manual.newSource().getGenerator();
+        for(unsigned int i=0; i<1000; ++i) assert(drawn[t][i] == gen.next());
+    }
+}
+
+// parallel fills are the same for any number of threads
+template<typename GenImpl>
+void testParallelFill(int seed) {
+    SequenceSplitting<GenImpl,true,Splitmix64> source(seed);
+    const std::size_t n = 10000, chunk = 999;
+
+    std::vector<double> sequential(n);
+    source.getGenerator().fill(sequential.data(), n);
+    std::vector<uint32_t> sequentialInts(n);
+    source.getGenerator().fill(sequentialInts.data(), n);
+
+    std::vector<int> ranges1(n);
+    std::vector<double> normals1(n);
+    parallelFillRange(source, ranges1.data(), n, -5, 17, 1u, chunk);
+    parallelFillNormal(source, normals1.data(), n, 0.0, 1.0, 1u, chunk);
+    for(int r : ranges1) assert(r >= -5 && r < 17);
+
+    ThreadPool pool(5);
+    for(unsigned int threads : {1u, 2u, 3u, 8u}) {
+        std::vector<double> u(n);
+        parallelFill(source, u.data(), n, threads, chunk);
+        assert(u == sequential);
+        std::vector<uint32_t> ints(n);
+        parallelFill(source, ints.data(), n, pool, chunk);
+        assert(ints == sequentialInts);
+
+        std::vector<int> ranges(n);
+        parallelFillRange(source, ranges.data(), n, -5, 17, threads, chunk);
+        assert(ranges == ranges1);
+        std::vector<double> normals(n);
+        parallelFillNormal(source, normals.data(), n, 0.0, 1.0, pool, chunk);
+        assert(normals == normals1);
+    }
+
+    // callers sharing one pool do not disturb each other
+    auto fillShared = [&]() {
+        auto own = source;
+        for(unsigned int round=0; round<20; ++round) {
+            std::vector<uint32_t> ints(n);
+            parallelFill(own, ints.data(), n, pool, chunk);
+            assert(ints == sequentialInts);
+        }
+    };
+    std::thread other(fillShared);
+    fillShared();
+    other.join();
+
+    bool refused = false;
+    try { parallelFill(source, sequential.data(), n, 2u, 0); } catch(const std::invalid_argument&) { refused = true; }
+    assert(refused);
+}
+
+int main() {
+    int seed = 4711;
+    testPool<Xoshiro256plus>(seed, 8);
+    testPool<Xorshift1024star>(seed, 4);
+    testPool<Xoshiro256plusX4>(seed, 3);
+
+    // without bind(): distinct slots, stable per thread, one per pool
+    GeneratorPool<Xoshiro256plus> poolA(SequenceSplitting<Xoshiro256plus,true,Splitmix64>(seed), 16);
+    GeneratorPool<Xoshiro256plus> poolB(SequenceSplitting<Xoshiro256plus,true,Splitmix64>(seed+1), 16);
+    std::vector<const void*> gens(16);
+    std::vector<std::thread> workers;
+    for(std::size_t t=0; t<16; ++t) {
+        workers.emplace_back([&, t]() {
+            auto* a = &poolA.local();
+            auto* b = &poolB.local();
+            assert(a != static_cast<void*>(b));
+            assert(a == &poolA.local());
+            assert(b == &poolB.local());
+            gens[t] = a;
+        });
+    }
+    for(auto& w : workers) w.join();
+    assert(std::set<const void*>(gens.begin(), gens.end()).size() == 16);
+
+    // bind(): an index held by another thread is refused, the index held
+    // before is released
+    GeneratorPool<Xoshiro256plus> poolC(SequenceSplitting<Xoshiro256plus,true,Splitmix64>(seed), 4);
+    auto* first = &poolC.local();
+    assert(first == &poolC.get(0));
+    std::thread([&]() {
+        bool refused = false;
+        try { poolC.bind(0); } catch(const std::logic_error&) { refused = true; }
+        assert(refused);
+        poolC.bind(2);
+        assert(&poolC.local() == &poolC.get(2));
+        poolC.bind(3);
+        assert(&poolC.local() == &poolC.get(3));
+    }).join();
+    poolC.bind(0);
+    poolC.bind(2);
+    assert(&poolC.local() == &poolC.get(2));
+    std::thread([&]() {
+        poolC.bind(0);
+        assert(&poolC.local() == &poolC.get(0));
+    }).join();
+
+    // local() past capacity throws, also when retried, and leaves the
+    // threads holding an index alone
+    GeneratorPool<Xoshiro256plus> poolD(SequenceSplitting<Xoshiro256plus,true,Splitmix64>(seed), 1);
+    auto* only = &poolD.local();
+    std::thread([&]() {
+        for(int attempt=0; attempt<2; ++attempt) {
+            bool full = false;
+            try { poolD.local(); } catch(const std::out_of_range&) { full = true; }
+            assert(full);
+        }
+    }).join();
+    assert(&poolD.local() == only && only == &poolD.get(0));
+
+    testParallelFill<Xoshiro256plus>(seed);
+    testParallelFill<Xoshiro256starstarX4>(seed);
+    testParallelFill<Xorshift1024star>(seed);
+
+    std::cout << "poolTest passed" << std::endl;
+    return(0);
+}
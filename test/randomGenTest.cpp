@@ -1,5 +1,6 @@
 
 #include "RandomGenerators.hpp" 
+#include "BufferedGenerator.hpp"
 
 #ifdef _USE_SIMDPP
 #define SIMDPP_ARCH_X86_SSE2 	
@@ -15,6 +16,15 @@
 #include <string>
 #include <assert.h>
 #include <typeinfo>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#ifdef PRNG_SEED_ATFORK
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
 
 using namespace PRNG;
 
@@ -118,6 +128,470 @@ int main() {
     std::cout << "rand()\t2\t" << xoshiroplus.rand<int>() << std::endl;
     std::cout << "rand()\t3\t" << xoshiroplus.rand<int>() << std::endl;
 
+    // Multi-lane engine: lane l equals the scalar generator after l jumps
+    auto checkLanes = [&](auto multi, auto scalar) {
+        const std::size_t lanes = decltype(multi)::lanes;
+        std::vector<decltype(scalar)> ref;
+        for(std::size_t l=0; l<lanes; ++l) {
+            ref.push_back(scalar);
+            scalar.jump();
+        }
+        for(unsigned int i=0; i<100; ++i) {
+            for(std::size_t l=0; l<lanes; ++l) {
+                assert(multi.next()==ref[l].next());
+            }
+        }
+    };
+    checkLanes(Xoshiro256plusX4(xoshiroplus.getState()), Xoshiro256plus(xoshiroplus.getState()));
+    checkLanes(Xoshiro256plusX8(xoshiroplus.getState()), Xoshiro256plus(xoshiroplus.getState()));
+    checkLanes(Xoshiro256starstarX4(xoshirostarstar.getState()), Xoshiro256starstar(xoshirostarstar.getState()));
+    checkLanes(Xoshiro256starstarX8(xoshirostarstar.getState()), Xoshiro256starstar(xoshirostarstar.getState()));
+
+    // Block generation: next_n() continues exactly where next() is
+    auto checkBlocks = [&](auto gen) {
+        auto ref = gen;
+        std::vector<uint64_t> block(1000);
+        gen.next(); ref.next();
+        for(std::size_t n : {1, 3, 7, 64, 925}) {
+            gen.next_n(block.data(), n);
+            for(std::size_t i=0; i<n; ++i) assert(block[i]==ref.next());
+            assert(gen.next()==ref.next());
+        }
+    };
+    checkBlocks(splitmix64(seed));
+    checkBlocks(xorshift1024star(seed));
+    checkBlocks(xorshift128plus(seed));
+    checkBlocks(xoroshiro128plus(seed));
+    checkBlocks(xoshiro256plus(seed));
+    checkBlocks(xoshiro256starstar(seed));
+    checkBlocks(Xoshiro256plusX4(xoshiroplus.getState()));
+    checkBlocks(Xoshiro256starstarX8(xoshirostarstar.getState()));
+
+    // fill() goes through next_n() and matches scalar rand<T>()
+    auto fillGen = xoshiroplusGen();
+    auto scalarGen = xoshiroplusGen();
+    std::vector<double> dfill(1000);
+    fillGen.fill(dfill.data(), dfill.size());
+    std::vector<uint64_t> ufill(1000);
+    fillGen.fill(ufill.data(), ufill.size());
+    for(unsigned int i=0; i<1000; ++i) assert(dfill[i]==scalarGen.rand<double>());
+    for(unsigned int i=0; i<1000; ++i) assert(ufill[i]==scalarGen.rand<uint64_t>());
+    std::vector<float> ffill(1000);
+    fillGen.fill(ffill.data(), ffill.size());
+    for(unsigned int i=0; i<1000; ++i) assert(ffill[i]==scalarGen.rand<float>());
+    // dense doubles: rand<double>() is the dense value rounded down to 2^-53
+    for(unsigned int i=0; i<1000; ++i) {
+        auto denseGen = fillGen;
+        const double dense = fillGen.randDoubleDense();
+        assert(dense > 0. && dense < 1.);
+        assert(std::floor(dense * 9007199254740992.) / 9007199254740992. == denseGen.rand<double>());
+        scalarGen.next();
+    }
+    {
+        using Dense = RandomGenerator<Xoshiro256plus>;
+        assert(Dense::denseDouble(UINT64_MAX) == 1. - 1./9007199254740992.);
+        assert(Dense::denseDouble(UINT64_C(1) << 63) == 0.5);
+        assert(Dense::denseDouble((UINT64_C(1) << 52) | 1) == std::ldexp(1. + std::ldexp(1., -52), -12));
+        std::vector<uint64_t> words;
+        auto next = [&]() { const uint64_t w = words.back(); words.pop_back(); return w; };
+        words = { UINT64_MAX };
+        assert(Dense::denseTail(UINT64_C(1), next) == std::ldexp(2. - std::ldexp(1., -52), -64));
+        words = { UINT64_C(1) << 63 };
+        assert(Dense::denseTail(UINT64_C(0), next) == std::ldexp(1., -65));
+        assert(words.empty());
+        words = { UINT64_C(0x8000000000000000) };
+        assert(Dense::denseTail(UINT64_C(0x0003), next) == std::ldexp(1.75, -63));
+        // subnormal results are rounded down too
+        words.assign(16, 0);
+        words[0] = UINT64_MAX;
+        assert(Dense::denseTail(UINT64_C(0), next) == std::ldexp(2. - std::ldexp(1., -49), -1025));
+        assert(words.empty());
+    }
+
+    // two floats per output, the first one is rand<float>()
+    for(unsigned int i=0; i<1000; ++i) {
+        auto pairGen = fillGen;
+        const std::array<float,2> pair = fillGen.randFloatPair();
+        assert(pair[0] == pairGen.rand<float>());
+        assert(pair[0] >= 0.f && pair[0] < 1.f && pair[1] >= 0.f && pair[1] < 1.f);
+        scalarGen.next();
+    }
+    assert(RandomGenerator<Xoshiro256plus>::floatPair(UINT64_MAX)[1] == 1.f - 1.f/16777216.f);
+    assert(RandomGenerator<Xoshiro256plus>::floatPair(UINT64_C(0xFFFFFFFF00000000))[1] == 0.f);
+    std::vector<double> dvec = fillGen.randVector<double>(300);
+    for(unsigned int i=0; i<300; ++i) assert(dvec[i]==scalarGen.rand<double>());
+
+    // uniform floating point values are in [0,1)
+    using XoshiroGen = RandomGenerator<Xoshiro256plus>;
+    assert(XoshiroGen::convert<double>(UINT64_MAX) < 1.0);
+    assert(XoshiroGen::convert<float>(UINT64_MAX) < 1.0f);
+    assert(XoshiroGen::convert<double>(UINT64_MAX) == 1.0 - 1.0/9007199254740992.);
+    assert(XoshiroGen::convert<double>(0) == 0.0);
+    assert(XoshiroGen::unitDouble(UINT64_MAX) == XoshiroGen::convert<double>(UINT64_MAX));
+
+    // randRange: bounds, fillRange equals repeated randRange (3*2^30 rejects every fourth raw)
+    auto checkRange = [&](auto start, auto end) {
+        using T = decltype(start);
+        auto bulkGen = xoshiroplusGen();
+        auto rangeGen = xoshiroplusGen();
+        std::vector<T> bulk(1000);
+        bulkGen.fillRange(bulk.data(), bulk.size(), start, end);
+        for(unsigned int i=0; i<1000; ++i) {
+            assert(bulk[i]==rangeGen.randRange(start,end));
+            assert(bulk[i]>=start && bulk[i]<end);
+        }
+        assert(bulkGen.next()==rangeGen.next());
+    };
+    checkRange(0,12);
+    checkRange(-7,5);
+    checkRange((int8_t)-100,(int8_t)100);
+    checkRange((uint32_t)0,(uint32_t)(3u<<30));
+    checkRange((int64_t)-1000,(int64_t)1);
+    checkRange((uint64_t)5,(uint64_t)(3ull<<62));
+
+    std::array<unsigned int,6> counts{};
+    auto dieGen = xoshiroplusGen();
+    for(unsigned int i=0; i<60000; ++i) ++counts[dieGen.randRange(0,6)];
+    for(unsigned int c : counts) assert(c > 9500 && c < 10500);
+
+    // randNormal: fillNormal equals repeated randNormal, moments and tail
+    auto normalGen = xoshiroplusGen();
+    auto bulkNormalGen = xoshiroplusGen();
+    std::vector<double> normals(200000);
+    bulkNormalGen.fillNormal(normals.data(), normals.size(), 1.0, 2.0);
+    double sum = 0, sumSq = 0;
+    std::size_t tail = 0;
+    for(double x : normals) {
+        assert(x==normalGen.randNormal(1.0, 2.0));
+        sum += x;
+        sumSq += (x-1.0)*(x-1.0);
+        if(std::abs(x-1.0) > 2.0*Ziggurat::r) ++tail;
+    }
+    assert(bulkNormalGen.next()==normalGen.next());
+    assert(std::abs(sum/normals.size() - 1.0) < 0.02);
+    assert(std::abs(sumSq/normals.size() - 4.0) < 0.05);
+    assert(tail > 10 && tail < 100);   // expected 200000*2.58e-4 = 52
+    // sign and layer come from the top bits, so a generator with weak low
+    // bits gives the same moments and a balanced sign
+    RandomGenerator<Xorshift128plus> weakGen(seed);
+    std::vector<double> weakNormals(200000);
+    weakGen.fillNormal(weakNormals.data(), weakNormals.size());
+    double weakSum = 0, weakSumSq = 0;
+    std::size_t negatives = 0;
+    for(double x : weakNormals) {
+        weakSum += x;
+        weakSumSq += x*x;
+        if(x < 0) ++negatives;
+    }
+    assert(std::abs(weakSum/weakNormals.size()) < 0.01);
+    assert(std::abs(weakSumSq/weakNormals.size() - 1.0) < 0.02);
+    assert(std::abs((double)negatives/weakNormals.size() - 0.5) < 0.005);
+    std::vector<float> fnormals(1000);
+    bulkNormalGen.fillNormal(fnormals.data(), fnormals.size());
+    for(float x : fnormals) assert(x==normalGen.randNormal<float>());
+
+    // AliasTable: frequencies follow the weights, batch equals repeated sample()
+    std::vector<double> weights{1, 0, 2, 7, 0.5, 4.5, 5};
+    AliasTable<> alias(weights);
+    auto aliasGen = xoshiroplusGen();
+    auto aliasBatchGen = xoshiroplusGen();
+    std::vector<uint32_t> categories(200000);
+    alias.sample(aliasBatchGen, categories.data(), categories.size());
+    std::vector<std::size_t> hist(weights.size());
+    for(uint32_t c : categories) {
+        assert(c==alias(aliasGen));
+        ++hist[c];
+    }
+    assert(aliasBatchGen.next()==aliasGen.next());
+    assert(hist[1]==0);
+    for(std::size_t i=0; i<weights.size(); ++i) {
+        const double expected = categories.size()*weights[i]/20.;
+        assert(std::abs(hist[i]-expected) < 5*std::sqrt(expected)+1);
+    }
+    std::vector<uint64_t> uniformWeights(1000, 3);
+    AliasTable<uint64_t> uniformAlias(uniformWeights);
+    for(unsigned int i=0; i<1000; ++i) assert(uniformAlias(aliasGen) < 1000);
+    // integer weights near 2^64/n, scaled in double
+    std::vector<uint64_t> largeWeights(16, UINT64_C(1) << 60);
+    largeWeights[0] = UINT64_C(4) << 60;
+    AliasTable<> largeAlias(largeWeights);
+    std::vector<std::size_t> largeHist(16);
+    for(unsigned int i=0; i<190000; ++i) ++largeHist[largeAlias(aliasGen)];
+    for(std::size_t i=0; i<16; ++i) {
+        const double expected = i==0 ? 40000. : 10000.;
+        assert(std::abs(largeHist[i]-expected) < 5*std::sqrt(expected));
+    }
+    auto rejects = [](const std::vector<double>& w) {
+        try { AliasTable<> table(w); } catch(const std::invalid_argument&) { return true; }
+        return false;
+    };
+    assert(rejects({1, -0.5, 2}));
+    assert(rejects({1, std::nan(""), 2}));
+    assert(rejects({1, std::numeric_limits<double>::infinity()}));
+    assert(rejects({0, 0}));
+    assert(rejects({}));
+    assert(!rejects({0, 1}));
+
+    // shuffle: a permutation, reproducible, uses exactly the outputs it draws
+    auto checkShuffle = [&](std::size_t n) {
+        auto shuffleGen = xoshiroplusGen();
+        auto repeatGen = xoshiroplusGen();
+        std::vector<uint32_t> perm(n), again(n);
+        for(std::size_t i=0; i<n; ++i) perm[i] = again[i] = i;
+        shuffleGen.shuffle(perm.begin(), perm.end());
+        repeatGen.shuffle(again.data(), again.data()+n);
+        assert(perm==again);
+        assert(shuffleGen.next()==repeatGen.next());
+        std::sort(again.begin(), again.end());
+        for(std::size_t i=0; i<n; ++i) assert(again[i]==i);
+    };
+    for(std::size_t n : {0, 1, 2, 5, 1000, 100000}) checkShuffle(n);
+    checkShuffle(Shuffle::cacheBlock + 12345);
+    auto consumedGen = xoshiroplusGen();
+    auto consumedRef = xoshiroplusGen();
+    std::array<int,5> five{{1,2,3,4,5}};
+    consumedGen.shuffle(five.begin(), five.end());   // one batch of bounds 5,4,3,2
+    consumedRef.next();
+    assert(consumedGen.next()==consumedRef.next());
+
+    // all 24 orders of 4 elements equally likely, plain and cache-blocked
+    auto checkOrders = [&](uint64_t block) {
+        auto orderGen = xoshiroplusGen();
+        std::array<std::size_t,256> orders{};
+        for(unsigned int r=0; r<48000; ++r) {
+            std::array<uint8_t,4> a{{0,1,2,3}};
+            Shuffle::shuffle(orderGen, a.begin(), a.end(), block);
+            ++orders[a[0]*64+a[1]*16+a[2]*4+a[3]];
+        }
+        std::size_t distinct = 0;
+        for(std::size_t c : orders) {
+            if(c==0) continue;
+            ++distinct;
+            assert(c > 1780 && c < 2220);
+        }
+        assert(distinct==24);
+    };
+    checkOrders(Shuffle::cacheBlock);
+    checkOrders(1);
+
+    // cache-blocked without a default constructor; a throwing move shuffles
+    // in place
+    struct NoDefault {
+        explicit NoDefault(uint32_t v_): v(v_) {}
+        uint32_t v;
+    };
+    struct ThrowingMove {
+        ThrowingMove(uint32_t v_): v(v_) {}
+        ThrowingMove(ThrowingMove&& o): v(o.v) {}
+        ThrowingMove& operator=(ThrowingMove&& o) { v = o.v; return *this; }
+        uint32_t v;
+    };
+    {
+        std::vector<NoDefault> blocked;
+        std::vector<ThrowingMove> plain;
+        std::vector<uint32_t> expectBlocked(5000), expectPlain(5000);
+        for(uint32_t i=0; i<5000; ++i) {
+            blocked.emplace_back(i);
+            plain.emplace_back(i);
+            expectBlocked[i] = expectPlain[i] = i;
+        }
+        auto blockedGen = xoshiroplusGen(), plainGen = xoshiroplusGen();
+        auto blockedRef = xoshiroplusGen(), plainRef = xoshiroplusGen();
+        Shuffle::shuffle(blockedGen, blocked.begin(), blocked.end(), 64);
+        Shuffle::shuffle(plainGen, plain.begin(), plain.end(), 64);
+        Shuffle::shuffle(blockedRef, expectBlocked.begin(), expectBlocked.end(), 64);
+        Shuffle::shuffle(plainRef, expectPlain.begin(), expectPlain.end());
+        for(uint32_t i=0; i<5000; ++i) {
+            assert(blocked[i].v == expectBlocked[i]);
+            assert(plain[i].v == expectPlain[i]);
+        }
+        assert(expectBlocked != expectPlain);
+    }
+
+    // sampleWithoutReplacement: distinct, in range, uniform (Floyd and partial shuffle)
+    auto checkSample = [&](int64_t n, int64_t k) {
+        auto sampleGen = xoshiroplusGen();
+        std::vector<std::size_t> hits(n);
+        std::vector<int64_t> s(k);
+        const unsigned int rounds = 200000/k;
+        for(unsigned int r=0; r<rounds; ++r) {
+            sampleGen.sampleWithoutReplacement(n, k, s.data());
+            std::vector<int64_t> sorted(s);
+            std::sort(sorted.begin(), sorted.end());
+            assert(std::adjacent_find(sorted.begin(), sorted.end())==sorted.end());
+            for(int64_t v : s) {
+                assert(v>=0 && v<n);
+                ++hits[v];
+            }
+        }
+        const double expected = (double)rounds*k/n;
+        for(std::size_t h : hits) assert(std::abs(h-expected) < 5*std::sqrt(expected));
+    };
+    checkSample(1000, 5);
+    checkSample(20, 5);
+    checkSample(7, 7);
+    std::vector<uint32_t> none;
+    xoshiroplusGen().sampleWithoutReplacement(10u, 0u, none.data());
+    bool thrown = false;
+    try { xoshiroplusGen().sampleWithoutReplacement(3, 4, a1); } catch(const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    // bit reservoir: high bits first, weak low bits skipped
+    auto starGen = xoshirostarstarGen();
+    auto starRef = starGen;
+    for(unsigned int round=0; round<3; ++round) {
+        uint64_t out = starRef.next();
+        for(int b=7; b>=0; --b) assert(starGen.randNarrow<uint8_t>() == (uint8_t)(out >> (8*b)));
+        out = starRef.next();
+        uint64_t bools = 0;
+        for(int b=63; b>=0; --b) bools = (bools << 1) | starGen.randBool();
+        assert(bools == out);
+        out = starRef.next();
+        assert(starGen.randNarrow<uint32_t>() == (uint32_t)(out >> 32));
+        assert(starGen.randNarrow<int16_t>() == (int16_t)(out >> 16));
+        assert(starGen.randNarrow<uint16_t>() == (uint16_t)out);
+    }
+    auto checkWeakBits = [&](auto weakGen, int weak) {
+        auto weakRef = weakGen;
+        std::vector<bool> stream;
+        for(unsigned int i=0; i<10; ++i) {
+            const uint64_t out = weakRef.next();
+            for(int b=63; b>=weak; --b) stream.push_back((out >> b) & 1);
+        }
+        std::size_t bit = 0;
+        for(unsigned int i=0; i<18; ++i) {
+            const unsigned int width = (i%3==0) ? 32 : (i%3==1 ? 5 : 17);
+            uint64_t expected = 0;
+            for(unsigned int b=0; b<width; ++b) expected = (expected << 1) | stream[bit++];
+            assert(weakGen.randBits(width) == expected);
+        }
+        std::size_t ones = 0;
+        for(unsigned int i=0; i<64000; ++i) ones += weakGen.randBool();
+        assert(ones > 31000 && ones < 33000);
+    };
+    checkWeakBits(xoshiroplusGen(), 3);
+    checkWeakBits(RandomGenerator<Xorshift1024star>(seed), 3);
+
+    // BufferedGenerator: same sequence as the wrapped generator across refills
+    auto checkBuffered = [&](auto buffered, auto ref) {
+        std::vector<double> dref(200), dbuf(200);
+        for(unsigned int round=0; round<20; ++round) {
+            assert(buffered.next()==ref.next());
+            assert(buffered.randDouble()==ref.randDouble());
+            assert(buffered.template rand<uint32_t>()==ref.template rand<uint32_t>());
+            assert(buffered.randRange(-3,1000)==ref.randRange(-3,1000));
+            assert(buffered.randNormal()==ref.randNormal());
+            const std::size_t n = 7*round+1;
+            buffered.fill(dbuf.data(), n);
+            ref.fill(dref.data(), n);
+            for(std::size_t i=0; i<n; ++i) assert(dbuf[i]==dref[i]);
+        }
+    };
+    checkBuffered(BufferedGenerator<Xoshiro256plus>(xoshiroplusGen()), xoshiroplusGen());
+    checkBuffered(BufferedGenerator<Xoshiro256plus,16>(xoshiroplusGen()), xoshiroplusGen());
+    checkBuffered(BufferedGenerator<Xorshift1024star,7>(seed), RandomGenerator<Xorshift1024star>(seed));
+    checkBuffered(BufferedGenerator<Xoshiro256starstarX4,64>(xoshirostarstar.getState()),
+                  RandomGenerator<Xoshiro256starstarX4>(xoshirostarstar.getState()));
+
+    RandomSpacing<Xoshiro256plusX4,true,Splitmix64> rsPersSourceXoshiroPlusX4(seed);
+    auto xoshiroplusX4 = rsPersSourceXoshiroPlusX4.getGenerator();
+    std::cout << "rand()\t1\t" << xoshiroplusX4.rand<int>() << std::endl;
+    std::cout << "rand()\t2\t" << xoshiroplusX4.rand<int>() << std::endl;
+
+    // jump() continues with the next block of lanes
+    Xoshiro256plusX4 laneJump(xoshiroplus.getState());
+    Xoshiro256plus laneRef(xoshiroplus.getState());
+    for(unsigned int i=0; i<4; ++i) laneRef.jump();
+    laneJump.jump();
+    assert(laneJump.next()==laneRef.next());
+
+    // Runtime dispatch: every level up to the detected one gives the baseline results
+    auto dispatchRun = [&]() {
+        std::vector<double> out;
+        RandomGenerator<Xoshiro256plus> gen(seed);
+        std::vector<uint64_t> u64(1001);
+        std::vector<double> dbl(1001), nrm(1001);
+        std::vector<float> flt(1001);
+        std::vector<uint32_t> rng(1001);
+        gen.fill(u64.data(), u64.size());
+        gen.fill(dbl.data(), dbl.size());
+        gen.fill(flt.data(), flt.size());
+        gen.fillRange(rng.data(), rng.size(), uint32_t(3), uint32_t(3000000001u));
+        gen.fillNormal(nrm.data(), nrm.size(), 1.0, 2.0);
+        for(std::size_t i=0; i<1001; ++i) {
+            out.push_back((double)u64[i]);
+            out.push_back(dbl[i]);
+            out.push_back(flt[i]);
+            out.push_back(rng[i]);
+            out.push_back(nrm[i]);
+        }
+        Xorshift1024star jumper = RandomGenImplInitiator<Xorshift1024star>::get(seed);
+        jumper.jumpAhead(12345);
+        for(auto w : jumper.getState()) out.push_back((double)w);
+        BufferedGenerator<Philox4x32> buffered(seed);
+        for(unsigned int i=0; i<300; ++i) out.push_back((double)buffered.next());
+        return out;
+    };
+    const SimdLevel detected = detectSimdLevel();
+    const SimdLevel previous = setSimdLevel(SimdLevel::Baseline);
+    assert(simdLevel()==SimdLevel::Baseline);
+    const auto baseline = dispatchRun();
+    for(int level=1; level<=(int)detected; ++level) {
+        setSimdLevel((SimdLevel)level);
+        assert(simdLevel()==(SimdLevel)level);
+        assert(dispatchRun()==baseline);
+    }
+    setSimdLevel(previous);
+
+    //! Seeding: distinct seeds per call, thread, entropy source and fork
+    {
+        std::unordered_set<uint64_t> seeds;
+        for(unsigned int i=0; i<3*seedBatchSize; ++i) assert(seeds.insert(entropySeed()).second);
+        std::vector<uint64_t> bulk(5000);
+        entropySeeds(bulk.data(), bulk.size());
+        for(uint64_t s : bulk) assert(seeds.insert(s).second);
+
+        std::vector<uint64_t> threaded(8 * 100);
+        std::vector<std::thread> threads;
+        for(unsigned int t=0; t<8; ++t) {
+            threads.emplace_back([&threaded, t]() {
+                for(unsigned int i=0; i<100; ++i) threaded[t*100+i] = entropySeed();
+            });
+        }
+        for(auto& t : threads) t.join();
+        for(uint64_t s : threaded) assert(seeds.insert(s).second);
+
+        const EntropySource before = setEntropySource(EntropySource::Rdseed);
+        std::cout << "rdseed	" << hasRdseed() << std::endl;
+        entropySeeds(bulk.data(), 100);
+        for(unsigned int i=0; i<100; ++i) assert(seeds.insert(bulk[i]).second);
+        setEntropySource(before);
+
+        // unseeded generators and sources draw their seeds from here
+        assert(RandomGenerator<Xoshiro256plus>().next() != RandomGenerator<Xoshiro256plus>().next());
+        assert(RandomSpacing<Xoshiro256plus>().getGenerator().next() != RandomSpacing<Xoshiro256plus>().getGenerator().next());
+        assert(SequenceSplitting<Xoshiro256plus>().getGenerator().next() != SequenceSplitting<Xoshiro256plus>().getGenerator().next());
+
+#ifdef PRNG_SEED_ATFORK
+        // a child does not reuse the rest of the batch of its parent
+        entropySeed();
+        int fds[2];
+        assert(pipe(fds) == 0);
+        const pid_t child = fork();
+        if(child == 0) {
+            const uint64_t s = entropySeed();
+            _exit(write(fds[1], &s, sizeof(s)) == sizeof(s) ? 0 : 1);
+        }
+        uint64_t childSeed = 0;
+        assert(read(fds[0], &childSeed, sizeof(childSeed)) == sizeof(childSeed));
+        waitpid(child, nullptr, 0);
+        close(fds[0]);
+        close(fds[1]);
+        assert(childSeed != entropySeed());
+        assert(seeds.insert(childSeed).second);
+#endif
+    }
+
 #ifdef _USE_SIMDPP
     RandomSpacing<Xoshiro256starstarSIMDPP,true,Splitmix64> rsPersSourceXoshiroStarstarSIMD(seed);
     auto xoshirostarstarSIMDGen = [&](){return rsPersSourceXoshiroStarstarSIMD.getGenerator();};
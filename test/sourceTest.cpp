@@ -1,8 +1,12 @@
 #include "RandomGenerators.hpp" 
+#include "StaticSplitting.hpp"
+#include "StateArena.hpp"
 
 #include <iostream>
 #include <string>
 #include <assert.h>
+#include <cstdio>
+#include <stdexcept>
 
 using namespace PRNG;
 
@@ -65,6 +69,75 @@ auto simpleTestNonPersSource = [](auto&& source, bool verb) {
     assert(!vecEqual(vec2,vec3));
 };
 
+// StaticSequenceSplitting<GenImpl,4711,3,1,2> against the runtime splits
+template<typename GenImpl>
+void testStaticSource() {
+    using Root = StaticSequenceSplitting<GenImpl,4711>;
+    SequenceSplitting<GenImpl,true,Splitmix64> root(4711);
+    assert(root.getGenerator().next() == Root::getGenerator().next());
+
+    root.newSource();
+    root.newSource();
+    auto s3 = root.newSource();
+    auto s31 = s3.newSource();
+    s31.newSource();
+    auto s312 = s31.newSource();
+    assert(s312.getGenerator().next() == (Root::template getGenerator<3,1,2>().next()));
+    using S312 = typename Root::template Child<3>::template Child<1>::template Child<2>;
+    static_assert(S312::index == SplitTree<GenImpl>::child(SplitTree<GenImpl>::child(SplitTree<GenImpl>::child(1,3),1),2),
+                  "static node index");
+    assert(S312::getGenerator().next() == s312.getGenerator().next());
+
+    // further runtime splitting continues the tree
+    auto dyn = S312::source();
+    assert(dyn.newSource().getGenerator().next() == s312.newSource().getGenerator().next());
+}
+
+// StateArena: generators and sources continue exactly after a restart
+template<typename GenImpl>
+void testArena(const std::string& path) {
+    using Gen    = RandomGenerator<GenImpl>;
+    using Source = SequenceSplitting<GenImpl,true,Splitmix64>;
+    const std::size_t n = 100;
+    Source root(4711);
+    std::vector<Gen> ref;
+    std::vector<Source> refSources;
+    {
+        auto gens = StateArena<Gen>::create(path, n, root.getGenerator());
+        for(std::size_t i=0; i<n; ++i) {
+            gens[i] = root.newSource().getGenerator();
+            for(std::size_t k=0; k<i; ++k) gens[i].next();
+            gens[i].randBool();             // partly used bit reservoir
+            ref.push_back(gens[i]);
+        }
+        gens.sync();
+        auto sources = StateArena<Source>::create(path + ".src", n, root);
+        for(std::size_t i=0; i<n; ++i) {
+            sources[i] = root.newSource();
+            for(std::size_t k=0; k<i%5; ++k) sources[i].newSource();
+            refSources.push_back(sources[i]);
+        }
+        sources.sync();
+    }
+    auto gens = StateArena<Gen>::open(path);
+    auto sources = StateArena<Source>::open(path + ".src");
+    assert(gens.size()==n && sources.size()==n);
+    for(std::size_t i=0; i<n; ++i) {
+        assert(gens[i].randBool()==ref[i].randBool());
+        assert(gens[i].next()==ref[i].next());
+        assert(sources[i].newSource().getGenerator().next()==refSources[i].newSource().getGenerator().next());
+    }
+    bool rejected = false;
+    try {
+        StateArena<Source>::open(path);
+    } catch(const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    std::remove(path.c_str());
+    std::remove((path + ".src").c_str());
+}
+
 int main() {
     int seed=123;
     std::cout << "=== Test perservative source Random Spacing===" << std::endl;
@@ -87,6 +160,30 @@ int main() {
     simpleTestNonPersSource(ssNonPersSource,true);
 
 
+    std::cout << std::endl;
+    std::cout << "=== Test perservative source Sequence Splitting (multi-lane)===" << std::endl;
+    SequenceSplitting<Xoshiro256plusX4,true,Splitmix64> ssPersSourceX4(seed);
+    simpleTestPersSource(ssPersSourceX4,true);
+
+
+    std::cout << std::endl;
+    std::cout << "=== Test static source Sequence Splitting===" << std::endl;
+    testStaticSource<Xoshiro256plus>();
+    testStaticSource<Xoroshiro128plus>();
+    testStaticSource<Xorshift128plus>();
+    testStaticSource<Philox4x32>();
+    // 70 first splits exceed the node index range
+    auto deep = SequenceSplitting<Philox4x32,true,Splitmix64>(4711);
+    for(int i=0; i<70; ++i) deep = deep.newSource();
+    using Deep = StaticSequenceSplitting<Philox4x32,4711,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+                                         1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1>;
+    assert(deep.getGenerator().next() == Deep::getGenerator().next());
+    std::cout << "static sources match" << std::endl;
+
+    std::cout << "=== Test state arena===" << std::endl;
+    testArena<Xorshift1024star>("sourceTest.states");
+    testArena<Xoshiro256plus>("sourceTest.states");
+    testArena<Philox4x32>("sourceTest.states");
 
     return(0);
 }
@@ -0,0 +1,296 @@
+#include "RandomGenerators.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <system_error>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+using namespace PRNG;
+
+/*
+ * cpprand-stream - raw random data on stdout or into a file
+ *
+ *   cpprand-stream [--generator=NAME] [--source=spacing|splitting] [--seed=N]
+ *                  [--split=A,B,...] [--format=bytes|u32|u64|double]
+ *                  [--bytes=N] [--output=FILE] [--buffer=BYTES]
+ *
+ * The generator is getGenerator() of RandomSpacing<GenImpl,true,Splitmix64>
+ * or SequenceSplitting<GenImpl,true,Splitmix64> of seed, after the
+ * newSource() calls of the split path (numbered as for
+ * StaticSequenceSplitting: 3,1 is the first newSource() of the third
+ * newSource() of the root). bytes and u64 are the raw outputs, u32 and
+ * double the values of fill<uint32_t> and fill<double>, all in native byte
+ * order. Without --bytes the stream is endless.
+ *
+ * A producer thread fills buffers that the main thread writes. Into a pipe
+ * the buffers are vmspliced (the pipe references the pages, nothing is
+ * copied): the pipe is sized to one buffer, so once a buffer is spliced
+ * completely the one before has been read and may be refilled. Otherwise,
+ * or if the pipe can not be sized, plain write() of whole buffers.
+ */
+
+struct Options {
+    std::string generator = "xoshiro256plus";
+    std::string source    = "splitting";
+    std::string format    = "u64";
+    std::string output;
+    uint64_t    seed      = 0;
+    std::vector<unsigned int> split;
+    uint64_t    bytes     = 0;          // 0: endless
+    bool        limited   = false;
+    std::size_t buffer    = 1 << 20;
+};
+
+/* Buffers handed between the producer and the writer. */
+struct BufferQueue {
+    std::mutex              mutex;
+    std::condition_variable changed;
+    std::deque<std::size_t> free, full;
+    std::vector<std::size_t> sizes;
+    bool stop = false;
+
+    std::size_t take(std::deque<std::size_t>& from) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&]() { return stop || !from.empty(); });
+        if(from.empty()) return std::numeric_limits<std::size_t>::max();
+        const std::size_t b = from.front();
+        from.pop_front();
+        return b;
+    }
+    void give(std::deque<std::size_t>& to, std::size_t b) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            to.push_back(b);
+        }
+        changed.notify_all();
+    }
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        changed.notify_all();
+    }
+};
+
+struct Output {
+    int  fd;
+    bool splice = false;
+
+    /* Sizes the pipe to one buffer for vmsplice, if fd is a pipe. */
+    Output(int fd_, std::size_t buffer): fd(fd_) {
+#if defined(__linux__) && defined(F_SETPIPE_SZ)
+        struct stat st;
+        if(fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode)) {
+            const int size = fcntl(fd, F_SETPIPE_SZ, (int)buffer);
+            splice = size > 0 && (std::size_t)size <= buffer && buffer % (std::size_t)sysconf(_SC_PAGESIZE) == 0;
+        }
+#endif
+    }
+
+    /* All of [data,data+size); false once the reader is gone. */
+    bool write(const char* data, std::size_t size) {
+        while(size > 0) {
+            ssize_t n;
+#if defined(__linux__) && defined(F_SETPIPE_SZ)
+            if(splice) {
+                struct iovec iov = { (void*)data, size };
+                n = vmsplice(fd, &iov, 1, 0);
+            } else
+#endif
+            n = ::write(fd, data, size);
+            if(n < 0) {
+                if(errno == EINTR) continue;
+                if(errno == EPIPE) return false;
+                throw std::system_error(errno, std::generic_category(), "cpprand-stream: write");
+            }
+            data += n;
+            size -= n;
+        }
+        return true;
+    }
+};
+
+/* getGenerator() of the source reached by following split[depth..]. */
+template<typename Source>
+auto followPath(Source source, const std::vector<unsigned int>& split, std::size_t depth = 0) -> decltype(source.getGenerator()) {
+    if(depth == split.size()) return source.getGenerator();
+    for(unsigned int i=1; i<split[depth]; ++i) source.newSource();
+    return followPath(source.newSource(), split, depth+1);
+}
+
+template<typename GenImpl>
+RandomGenerator<GenImpl> makeGenerator(const Options& options, std::true_type) {
+    if(options.source == "splitting")
+        return followPath(SequenceSplitting<GenImpl,true,Splitmix64>(options.seed), options.split);
+    return followPath(RandomSpacing<GenImpl,true,Splitmix64>(options.seed), options.split);
+}
+template<typename GenImpl>
+RandomGenerator<GenImpl> makeGenerator(const Options& options, std::false_type) {
+    if(options.source == "splitting")
+        throw std::invalid_argument("cpprand-stream: " + options.generator + " does not support jump ahead, use --source=spacing");
+    return followPath(RandomSpacing<GenImpl,true,Splitmix64>(options.seed), options.split);
+}
+
+/* Fills buffer b with values of T, bytes at most; the number of bytes. */
+template<typename T, typename Gen>
+std::size_t produce(Gen& gen, char* b, std::size_t bytes) {
+    const std::size_t n = (bytes + sizeof(T) - 1) / sizeof(T);
+    gen.fill(reinterpret_cast<T*>(b), n);
+    return bytes;
+}
+
+template<typename GenImpl>
+int run(const Options& options) {
+    auto gen = makeGenerator<GenImpl>(options, std::integral_constant<bool, GenImpl::jumpAble>());
+
+    std::function<std::size_t(char*,std::size_t)> fill;
+    if(options.format == "bytes" || options.format == "u64")
+        fill = [&](char* b, std::size_t bytes) { return produce<uint64_t>(gen, b, bytes); };
+    else if(options.format == "u32")
+        fill = [&](char* b, std::size_t bytes) { return produce<uint32_t>(gen, b, bytes); };
+    else if(options.format == "double")
+        fill = [&](char* b, std::size_t bytes) { return produce<double>(gen, b, bytes); };
+    else
+        throw std::invalid_argument("cpprand-stream: unknown format " + options.format);
+
+    int fd = STDOUT_FILENO;
+    if(!options.output.empty()) {
+        fd = ::open(options.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0) throw std::system_error(errno, std::generic_category(), "cpprand-stream: " + options.output);
+    }
+    Output out(fd, options.buffer);
+
+    // vmsplice releases a buffer only after the next one, so one more
+    const std::size_t buffers = 4;
+    const std::size_t page = sysconf(_SC_PAGESIZE);
+    char* memory = nullptr;
+    if(posix_memalign((void**)&memory, page, buffers * options.buffer) != 0) throw std::bad_alloc();
+    std::unique_ptr<char, decltype(&std::free)> owner(memory, &std::free);
+
+    BufferQueue queue;
+    queue.sizes.resize(buffers);
+    for(std::size_t b=0; b<buffers; ++b) queue.free.push_back(b);
+
+    std::thread producer([&]() {
+        uint64_t remaining = options.bytes;
+        while(!options.limited || remaining > 0) {
+            const std::size_t b = queue.take(queue.free);
+            if(b >= buffers) return;
+            std::size_t bytes = options.buffer;
+            if(options.limited && remaining < bytes) bytes = remaining;
+            queue.sizes[b] = fill(memory + b*options.buffer, bytes);
+            remaining -= bytes;
+            queue.give(queue.full, b);
+        }
+        queue.finish();
+    });
+
+    // a write error stops the producer before it is reported
+    std::size_t previous = buffers;
+    try {
+        for(;;) {
+            const std::size_t b = queue.take(queue.full);
+            if(b >= buffers || !out.write(memory + b*options.buffer, queue.sizes[b])) break;
+            if(out.splice) {
+                if(previous < buffers) queue.give(queue.free, previous);
+                previous = b;
+            } else {
+                queue.give(queue.free, b);
+            }
+        }
+    } catch(...) {
+        queue.finish();
+        producer.join();
+        if(fd != STDOUT_FILENO) ::close(fd);
+        throw;
+    }
+    queue.finish();
+    producer.join();
+    if(fd != STDOUT_FILENO) ::close(fd);
+    return 0;
+}
+
+int usage(const char* name) {
+    std::cerr << "usage: " << name
+              << " [--generator=NAME] [--source=spacing|splitting] [--seed=N] [--split=A,B,...]"
+              << " [--format=bytes|u32|u64|double] [--bytes=N] [--output=FILE] [--buffer=BYTES]\n"
+              << "generators: splitmix64 xorshift1024star xorshift128plus xoroshiro128plus"
+              << " xoshiro256plus xoshiro256starstar xoshiro256plusx4 xoshiro256plusx8"
+              << " xoshiro256starstarx4 xoshiro256starstarx8 philox4x32" << std::endl;
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    try {
+        for(int i=1; i<argc; ++i) {
+            const std::string arg(argv[i]);
+            auto value = [&](const std::string& key) { return arg.substr(key.size()); };
+            if(arg.find("--generator=") == 0)   options.generator = value("--generator=");
+            else if(arg.find("--source=") == 0) options.source    = value("--source=");
+            else if(arg.find("--seed=") == 0)   options.seed      = std::stoull(value("--seed="), nullptr, 0);
+            else if(arg.find("--format=") == 0) options.format    = value("--format=");
+            else if(arg.find("--output=") == 0) options.output    = value("--output=");
+            else if(arg.find("--buffer=") == 0) options.buffer    = std::stoull(value("--buffer="), nullptr, 0);
+            else if(arg.find("--bytes=") == 0) {
+                options.bytes   = std::stoull(value("--bytes="), nullptr, 0);
+                options.limited = true;
+            } else if(arg.find("--split=") == 0) {
+                const std::string path = value("--split=");
+                for(std::size_t pos=0; pos<path.size(); ) {
+                    std::size_t end = path.find(',', pos);
+                    if(end == std::string::npos) end = path.size();
+                    const unsigned long n = std::stoul(path.substr(pos, end-pos));
+                    if(n == 0) throw std::invalid_argument("cpprand-stream: newSource() numbers start at 1");
+                    options.split.push_back(n);
+                    pos = end + 1;
+                }
+            }
+            else return usage(argv[0]);
+        }
+    } catch(const std::logic_error&) {
+        return usage(argv[0]);
+    }
+    if(options.source != "spacing" && options.source != "splitting") return usage(argv[0]);
+    if(options.buffer == 0 || options.buffer % 64 != 0) {
+        std::cerr << "cpprand-stream: the buffer size has to be a positive multiple of 64" << std::endl;
+        return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    try {
+        const std::string& g = options.generator;
+        if(g == "splitmix64")           return run<Splitmix64>(options);
+        if(g == "xorshift1024star")     return run<Xorshift1024star>(options);
+        if(g == "xorshift128plus")      return run<Xorshift128plus>(options);
+        if(g == "xoroshiro128plus")     return run<Xoroshiro128plus>(options);
+        if(g == "xoshiro256plus")       return run<Xoshiro256plus>(options);
+        if(g == "xoshiro256starstar")   return run<Xoshiro256starstar>(options);
+        if(g == "xoshiro256plusx4")     return run<Xoshiro256plusX4>(options);
+        if(g == "xoshiro256plusx8")     return run<Xoshiro256plusX8>(options);
+        if(g == "xoshiro256starstarx4") return run<Xoshiro256starstarX4>(options);
+        if(g == "xoshiro256starstarx8") return run<Xoshiro256starstarX8>(options);
+        if(g == "philox4x32")           return run<Philox4x32>(options);
+    } catch(const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return usage(argv[0]);
+}